@@ -0,0 +1,34 @@
+#include "Metrics.h"
+#include <cstdlib>
+#include <new>
+
+// Replaces the global allocation functions so Metrics can count heap
+// allocations. Linked into the game only. The standard nothrow forms
+// forward to these; over-aligned allocations keep their own pair and are
+// not counted.
+
+void* operator new(std::size_t size) {
+    Metrics::countAllocation(size);
+    if (void* memory = std::malloc(size ? size : 1)) return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
@@ -65,13 +65,13 @@ void BasicBolt::update(float deltaTime, const std::vector<Enemy*>& enemies) {
 }
 
 // Render the bolt (and debug visuals if enabled)
-void BasicBolt::draw(sf::RenderWindow& window) {
+void BasicBolt::draw(RenderSnapshot& frame) {
     if (!alive) return;
 
-    window.draw(shape);  // Draw main shape
+    frame.draw(shape);  // Draw main shape
 
     if (showDebug) {
-        window.draw(collisionDebug);  // Draw collision box (debug)
+        frame.draw(collisionDebug);  // Draw collision box (debug)
     }
 }
 
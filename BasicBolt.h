@@ -1,6 +1,7 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 #include "Enemy.h"
+#include "RenderSnapshot.h"
 #include <vector>
 
 class BasicBolt {
@@ -13,7 +14,7 @@ public:
     void update(float deltaTime, const std::vector<Enemy*>& enemies);
     
     // Render the bolt to the window
-    void draw(sf::RenderWindow& window);
+    void draw(RenderSnapshot& frame);
     
     // Check if the bolt is active/alive
     bool isAlive() const;
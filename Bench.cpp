@@ -0,0 +1,367 @@
+#include "Bitboard.h"
+#include "LevelGenerator.h"
+#include "Pathfinder.h"
+#include "RegionMap.h"
+#include "Rng.h"
+#include "RoomConnector.h"
+#if defined(MAZE_BENCH_GAMEPLAY)
+#include "Enemy.h"
+#include "Player.h"
+#include "Steering.h"
+#include "TextureCache.h"
+#endif
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Microbenchmarks of the simulation hot paths on fixed seeds, so two runs
+// (or two commits) can be diffed row by row.
+//
+//   mazebench [--runs N] [--out FILE] [--filter TEXT]
+//
+// Every case runs once to warm up, then --runs times (default 5). Output is
+// one CSV row per case, printed and written to --out (default
+// bench_output.txt):
+//
+//   benchmark,size,runs,ops,min_ms,median_ms,mean_ms,ns_per_op
+//
+// ops is how many operations one run does; ns_per_op uses the median.
+// Cases:
+//   generate_level   LevelGenerator::generate, size = level
+//   connect_rooms    region labelling plus RoomConnector::findLinks, what
+//                    connectMainRooms runs, size = rooms on a 256x256 grid
+//   validate_path    the exit reachability check: RegionMap::build and
+//                    sameRegion on a generated level, size = level
+//   flood_bitboard   Bitboard::floodFill from the player start, size = level
+//   flood_scalar     the same fill as a tile-by-tile std::queue BFS over the
+//                    generator grid, size = level
+//   find_path        A* from the player start to the exit, the search behind
+//                    Enemy::updatePathfinding, size = level
+//   wall_collision   the wall tests of Game::update for 10000 boxes:
+//                    pyramid reject, merged box query, distance field
+//                    push-out, size = level
+//   enemy_update     one second of Enemy::update (pathfinding and steering)
+//                    for every enemy, size = enemies; only built with the game
+//   enemy_steering   one second of Steering::force alone (seek, crowd
+//                    avoidance, wall push) for every enemy, size = enemies;
+//                    only built with the game
+
+namespace {
+    const std::uint64_t benchSeed = 1;
+
+    struct Result {
+        std::string name;
+        int size = 0;
+        long long ops = 0;
+        std::vector<double> times; // ms, one per run
+    };
+
+    struct Options {
+        int runs = 5;
+        std::string outPath = "bench_output.txt";
+        std::string filter;
+    };
+
+    // Results are summed in here so no timed work can be optimised away
+    volatile std::uint64_t sink = 0;
+
+    // Times body and appends the result, unless --filter leaves the case out.
+    // setup runs before every run, untimed.
+    void measure(const Options& options, std::vector<Result>& results, const std::string& name, int size,
+        long long ops, const std::function<void()>& setup, const std::function<void()>& body) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+        Result result{ name, size, ops, {} };
+        for (int run = -1; run < options.runs; run++) {
+            setup();
+            auto start = std::chrono::steady_clock::now();
+            body();
+            auto finish = std::chrono::steady_clock::now();
+            if (run >= 0) {
+                result.times.push_back(std::chrono::duration<double, std::milli>(finish - start).count());
+            }
+        }
+        results.push_back(std::move(result));
+    }
+
+    void writeRow(std::ostream& out, const Result& result) {
+        std::vector<double> sorted = result.times;
+        std::sort(sorted.begin(), sorted.end());
+        double mean = 0.0;
+        for (double time : sorted) mean += time;
+        mean /= sorted.size();
+        double median = sorted[sorted.size() / 2];
+
+        out << result.name << "," << result.size << "," << sorted.size() << "," << result.ops << ",";
+        std::ios::fmtflags flags = out.flags();
+        out.setf(std::ios::fixed);
+        out.precision(4);
+        out << sorted.front() << "," << median << "," << mean << ",";
+        out.precision(1);
+        out << median * 1e6 / result.ops << "\n";
+        out.flags(flags);
+    }
+
+    // Walled grid with rectangular rooms carved at random, most of them apart
+    std::vector<std::vector<int>> roomGrid(int side, int rooms, Rng& rng) {
+        std::vector<std::vector<int>> grid(side, std::vector<int>(side, 1));
+        for (int i = 0; i < rooms; i++) {
+            int width = rng.range(3, 10);
+            int height = rng.range(3, 10);
+            int x = rng.range(1, side - width - 2);
+            int y = rng.range(1, side - height - 2);
+            for (int ty = y; ty < y + height; ty++) {
+                std::fill(grid[ty].begin() + x, grid[ty].begin() + x + width, 0);
+            }
+        }
+        return grid;
+    }
+
+    sf::Vector2i tileOf(sf::Vector2f position) {
+        return sf::Vector2i(static_cast<int>(position.x / LevelGenerator::tileSize),
+            static_cast<int>(position.y / LevelGenerator::tileSize));
+    }
+
+    // Random floor tiles, the same ones for the same level
+    std::vector<sf::Vector2i> floorTiles(const Level& level, int count, Rng& rng) {
+        std::vector<sf::Vector2i> tiles;
+        while (static_cast<int>(tiles.size()) < count) {
+            sf::Vector2i tile(rng.range(0, level.maze.getWidth() - 1), rng.range(0, level.maze.getHeight() - 1));
+            if (!level.maze.isWall(tile.x, tile.y)) tiles.push_back(tile);
+        }
+        return tiles;
+    }
+
+    // The tile-at-a-time fill Bitboard::floodFill replaced, for comparison
+    int scalarFloodFill(const std::vector<std::vector<int>>& grid, sf::Vector2i start) {
+        int height = static_cast<int>(grid.size());
+        int width = static_cast<int>(grid[0].size());
+        std::vector<std::vector<char>> visited(height, std::vector<char>(width, 0));
+        std::queue<sf::Vector2i> open;
+        open.push(start);
+        visited[start.y][start.x] = 1;
+        int reached = 0;
+
+        const int dx[4] = { 1, -1, 0, 0 };
+        const int dy[4] = { 0, 0, 1, -1 };
+        while (!open.empty()) {
+            sf::Vector2i tile = open.front();
+            open.pop();
+            reached++;
+            for (int d = 0; d < 4; d++) {
+                int nx = tile.x + dx[d];
+                int ny = tile.y + dy[d];
+                if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+                if (visited[ny][nx] || grid[ny][nx] != 0) continue;
+                visited[ny][nx] = 1;
+                open.push({ nx, ny });
+            }
+        }
+        return reached;
+    }
+
+    std::unique_ptr<Level> generateLevel(int number) {
+        LevelGenerator generator;
+        return generator.generate(number, benchSeed);
+    }
+
+    void levelSuites(const Options& options, std::vector<Result>& results) {
+        const int levels[] = { 1, 5, 10, 20 };
+        // 288x288 up to 1248x1248
+        const int fillLevels[] = { 20, 40, 100 };
+
+        for (int number : levels) {
+            LevelGenerator generator;
+            measure(options, results, "generate_level", number, 1, [] {}, [&] {
+                sink += generator.generate(number, benchSeed)->repairs;
+            });
+        }
+
+        for (int rooms : { 16, 64, 256 }) {
+            std::vector<std::vector<int>> grid;
+            RegionMap regions;
+            RoomConnector connector;
+            measure(options, results, "connect_rooms", rooms, 1, [&] {
+                Rng rng = Rng(benchSeed).split(rooms);
+                grid = roomGrid(256, rooms, rng);
+            }, [&] {
+                regions.build(grid);
+                sink += connector.findLinks(grid, regions).size();
+            });
+        }
+
+        for (int number : levels) {
+            std::unique_ptr<Level> level = generateLevel(number);
+            sf::Vector2i start = tileOf(level->playerStart);
+            sf::Vector2i exit = tileOf(level->exitPosition);
+            RegionMap regions;
+            measure(options, results, "validate_path", number, 1, [] {}, [&] {
+                regions.build(level->maze);
+                sink += regions.sameRegion(start, exit);
+            });
+
+            std::vector<sf::Vector2i> path;
+            measure(options, results, "find_path", number, 1, [] {}, [&] {
+                Pathfinder::findPath(level->maze, start, exit, path);
+                sink += path.size();
+            });
+
+            // Boxes about the size of the player around random floor tiles
+            const int boxCount = 10000;
+            const float tileSize = LevelGenerator::tileSize;
+            Rng rng = Rng(benchSeed).split(number);
+            std::vector<sf::FloatRect> boxes;
+            for (const sf::Vector2i& tile : floorTiles(*level, boxCount, rng)) {
+                float x = (tile.x + rng.range(0.f, 1.f)) * tileSize;
+                float y = (tile.y + rng.range(0.f, 1.f)) * tileSize;
+                boxes.emplace_back(x - 12.f, y - 12.f, 24.f, 24.f);
+            }
+            std::vector<WallMesh::Rect> nearby;
+            measure(options, results, "wall_collision", number, boxCount, [] {}, [&] {
+                for (const sf::FloatRect& box : boxes) {
+                    // Same tests as Game::touchesWall, resolvePlayerCollision and updateEnemies
+                    TileMap::TileRect area{
+                        static_cast<int>(std::floor(box.left / tileSize)),
+                        static_cast<int>(std::floor(box.top / tileSize)),
+                        static_cast<int>(std::ceil((box.left + box.width) / tileSize)) - 1,
+                        static_cast<int>(std::ceil((box.top + box.height) / tileSize)) - 1
+                    };
+                    if (level->occupancy.anyWall(area.x0, area.y0, area.x1, area.y1)) {
+                        nearby.clear();
+                        level->wallMesh.query(area, nearby);
+                        for (const WallMesh::Rect& wall : nearby) {
+                            sf::FloatRect wallRect(wall.x * tileSize, wall.y * tileSize, wall.width * tileSize, wall.height * tileSize);
+                            sink += box.intersects(wallRect);
+                        }
+                    }
+                    sf::Vector2f center(box.left + box.width / 2, box.top + box.height / 2);
+                    if (level->walls.sample(center / tileSize) * tileSize < box.width / 2) {
+                        sf::Vector2f push = level->walls.gradient(center / tileSize);
+                        sink += push.x > 0.f;
+                    }
+                }
+            });
+        }
+
+        for (int number : fillLevels) {
+            std::unique_ptr<Level> level = generateLevel(number);
+            sf::Vector2i start = tileOf(level->playerStart);
+            Bitboard floor = level->maze.walkable();
+            measure(options, results, "flood_bitboard", number, 1, [] {}, [&] {
+                sink += floor.floodFill(start.x, start.y).count();
+            });
+
+            std::vector<std::vector<int>> grid(level->maze.getHeight(), std::vector<int>(level->maze.getWidth()));
+            for (int y = 0; y < level->maze.getHeight(); y++) {
+                for (int x = 0; x < level->maze.getWidth(); x++) {
+                    grid[y][x] = level->maze.get(x, y);
+                }
+            }
+            measure(options, results, "flood_scalar", number, 1, [] {}, [&] {
+                sink += scalarFloodFill(grid, start);
+            });
+        }
+    }
+
+#if defined(MAZE_BENCH_GAMEPLAY)
+    void enemySuites(const Options& options, std::vector<Result>& results) {
+        const int steps = 60;
+        const float step = 1.f / 60.f;
+        std::unique_ptr<Level> level = generateLevel(10);
+        Player player;
+
+        for (int count : { 10, 100, 1000 }) {
+            std::vector<std::unique_ptr<Enemy>> enemies;
+            std::vector<Enemy*> pointers;
+            // Fresh enemies on the same tiles each run, so every run repaths alike
+            auto spawn = [&] {
+                player.reset();
+                player.setPosition(level->playerStart);
+                enemies.clear();
+                pointers.clear();
+                Rng rng = Rng(benchSeed).split(count);
+                for (const sf::Vector2i& tile : floorTiles(*level, count, rng)) {
+                    sf::Vector2f position((tile.x + 0.5f) * LevelGenerator::tileSize, (tile.y + 0.5f) * LevelGenerator::tileSize);
+                    auto enemy = std::make_unique<Enemy>(position, 100.f, Enemy::BASIC);
+                    enemy->setPlayer(&player);
+                    enemy->setRegionMap(&level->regions);
+                    enemy->setWallField(&level->walls);
+                    enemy->setOccupancy(&level->occupancy);
+                    pointers.push_back(enemy.get());
+                    enemies.push_back(std::move(enemy));
+                }
+            };
+            measure(options, results, "enemy_update", count, static_cast<long long>(steps) * count, spawn, [&] {
+                for (int i = 0; i < steps; i++) {
+                    for (auto& enemy : enemies) {
+                        enemy->update(step, level->maze, LevelGenerator::tileSize, pointers);
+                    }
+                }
+            });
+            measure(options, results, "enemy_steering", count, static_cast<long long>(steps) * count, spawn, [&] {
+                for (int i = 0; i < steps; i++) {
+                    for (auto& enemy : enemies) {
+                        sf::Vector2f force = Steering::force(enemy->getPosition(), player.getPosition(), nullptr,
+                            pointers, enemy.get(), &level->walls, LevelGenerator::tileSize);
+                        sink += force.x > 0.f;
+                    }
+                }
+            });
+        }
+    }
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) {
+            options.runs = std::max(1, std::stoi(argv[++i]));
+        }
+        else if (arg == "--out" && i + 1 < argc) {
+            options.outPath = argv[++i];
+        }
+        else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        }
+        else {
+            std::cerr << "Unknown argument " << arg << std::endl;
+            return 1;
+        }
+    }
+
+#if defined(MAZE_BENCH_GAMEPLAY)
+    TextureCache::setGraphicsEnabled(false);
+#endif
+
+    std::vector<Result> results;
+    levelSuites(options, results);
+#if defined(MAZE_BENCH_GAMEPLAY)
+    enemySuites(options, results);
+#endif
+
+    std::ofstream out(options.outPath, std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Cannot write " << options.outPath << std::endl;
+        return 1;
+    }
+    const char* header = "benchmark,size,runs,ops,min_ms,median_ms,mean_ms,ns_per_op\n";
+    out << header;
+    std::cout << header;
+    for (const Result& result : results) {
+        writeRow(out, result);
+        writeRow(std::cout, result);
+    }
+    return 0;
+}
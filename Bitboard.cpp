@@ -0,0 +1,263 @@
+#include "Bitboard.h"
+#include <algorithm>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    int popcount64(std::uint64_t word) {
+#if defined(_MSC_VER)
+        return static_cast<int>(__popcnt64(word));
+#else
+        return __builtin_popcountll(word);
+#endif
+    }
+
+    int trailingZeros64(std::uint64_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctzll(word);
+#endif
+    }
+
+    // Occluded fills (Kogge-Stone): spread generators through contiguous
+    // propagator bits in log2(64) steps. generators must be a subset of
+    // propagators.
+    std::uint64_t fillUp(std::uint64_t generators, std::uint64_t propagators) {
+        generators |= propagators & (generators << 1);
+        propagators &= propagators << 1;
+        generators |= propagators & (generators << 2);
+        propagators &= propagators << 2;
+        generators |= propagators & (generators << 4);
+        propagators &= propagators << 4;
+        generators |= propagators & (generators << 8);
+        propagators &= propagators << 8;
+        generators |= propagators & (generators << 16);
+        propagators &= propagators << 16;
+        generators |= propagators & (generators << 32);
+        return generators;
+    }
+
+    std::uint64_t fillDown(std::uint64_t generators, std::uint64_t propagators) {
+        generators |= propagators & (generators >> 1);
+        propagators &= propagators >> 1;
+        generators |= propagators & (generators >> 2);
+        propagators &= propagators >> 2;
+        generators |= propagators & (generators >> 4);
+        propagators &= propagators >> 4;
+        generators |= propagators & (generators >> 8);
+        propagators &= propagators >> 8;
+        generators |= propagators & (generators >> 16);
+        propagators &= propagators >> 16;
+        generators |= propagators & (generators >> 32);
+        return generators;
+    }
+
+    // out = current | (mask & (above | below)) word by word: the tiles of a
+    // row reached from the rows next to it
+    void growRow(std::uint64_t* out, const std::uint64_t* current, const std::uint64_t* mask,
+        const std::uint64_t* above, const std::uint64_t* below, int words) {
+        int word = 0;
+#if defined(__AVX2__)
+        for (; word + 4 <= words; word += 4) {
+            __m256i neighbours = _mm256_or_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(above + word)),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(below + word)));
+            __m256i grown = _mm256_or_si256(
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + word)),
+                _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + word)), neighbours));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + word), grown);
+        }
+#endif
+        for (; word < words; word++) {
+            out[word] = current[word] | (mask[word] & (above[word] | below[word]));
+        }
+    }
+}
+
+Bitboard::Bitboard(int width, int height)
+    : width(std::max(0, width)), height(std::max(0, height)) {
+    wordsPerRow = (this->width + 63) / 64;
+    bits.assign(static_cast<size_t>(wordsPerRow) * this->height, 0);
+}
+
+Bitboard Bitboard::fromGrid(const std::vector<std::vector<int>>& grid) {
+    int gridHeight = static_cast<int>(grid.size());
+    int gridWidth = gridHeight > 0 ? static_cast<int>(grid[0].size()) : 0;
+    Bitboard board(gridWidth, gridHeight);
+
+    for (int y = 0; y < gridHeight; y++) {
+        std::uint64_t* words = board.row(y);
+        const int* tiles = grid[y].data();
+        for (int x = 0; x < gridWidth; x++) {
+            words[x >> 6] |= static_cast<std::uint64_t>(tiles[x] == 0) << (x & 63);
+        }
+    }
+    return board;
+}
+
+bool Bitboard::get(int x, int y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+    return (row(y)[x >> 6] >> (x & 63)) & 1;
+}
+
+void Bitboard::set(int x, int y, bool value) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+    std::uint64_t bit = std::uint64_t(1) << (x & 63);
+    if (value) row(y)[x >> 6] |= bit;
+    else row(y)[x >> 6] &= ~bit;
+}
+
+void Bitboard::fillSpan(int y, int x0, int x1) {
+    if (y < 0 || y >= height) return;
+    x0 = std::max(0, x0);
+    x1 = std::min(width - 1, x1);
+    if (x0 > x1) return;
+
+    std::uint64_t* words = row(y);
+    int first = x0 >> 6;
+    int last = x1 >> 6;
+    std::uint64_t headMask = ~std::uint64_t(0) << (x0 & 63);
+    std::uint64_t tailMask = ~std::uint64_t(0) >> (63 - (x1 & 63));
+
+    if (first == last) {
+        words[first] |= headMask & tailMask;
+        return;
+    }
+    words[first] |= headMask;
+    for (int word = first + 1; word < last; word++) {
+        words[word] = ~std::uint64_t(0);
+    }
+    words[last] |= tailMask;
+}
+
+// Horizontal fill of target through mask: up pass then down pass, carrying
+// into the neighbouring word whenever a run reaches the word edge
+void Bitboard::fillRow(std::uint64_t* target, const std::uint64_t* mask) const {
+    std::uint64_t carry = 0;
+    for (int word = 0; word < wordsPerRow; word++) {
+        std::uint64_t seeds = (target[word] | (carry & mask[word] & 1)) & mask[word];
+        target[word] = fillUp(seeds, mask[word]);
+        carry = target[word] >> 63;
+    }
+
+    carry = 0;
+    for (int word = wordsPerRow - 1; word >= 0; word--) {
+        std::uint64_t topBit = std::uint64_t(1) << 63;
+        std::uint64_t seeds = (target[word] | (carry ? mask[word] & topBit : 0)) & mask[word];
+        target[word] = fillDown(seeds, mask[word]);
+        carry = target[word] & 1;
+    }
+}
+
+// Row worklist: a row is refilled from its neighbours and, when it grew,
+// its neighbours are queued again. Each pass handles 64 tiles per word.
+Bitboard Bitboard::floodFill(int x, int y) const {
+    Bitboard result(width, height);
+    if (!get(x, y)) return result;
+
+    std::vector<int> pending{ y };
+    std::vector<char> queued(height, 0);
+    queued[y] = 1;
+    std::vector<std::uint64_t> grown(wordsPerRow);
+    std::vector<std::uint64_t> empty(wordsPerRow, 0);
+    bool seeded = false;
+
+    while (!pending.empty()) {
+        int ry = pending.back();
+        pending.pop_back();
+        queued[ry] = 0;
+
+        std::uint64_t* current = result.row(ry);
+        const std::uint64_t* mask = row(ry);
+        const std::uint64_t* above = ry > 0 ? result.row(ry - 1) : empty.data();
+        const std::uint64_t* below = ry + 1 < height ? result.row(ry + 1) : empty.data();
+
+        growRow(grown.data(), current, mask, above, below, wordsPerRow);
+        if (!seeded) {
+            grown[x >> 6] |= std::uint64_t(1) << (x & 63);
+            seeded = true;
+        }
+        fillRow(grown.data(), mask);
+
+        bool changed = false;
+        for (int word = 0; word < wordsPerRow; word++) {
+            if (grown[word] != current[word]) {
+                current[word] = grown[word];
+                changed = true;
+            }
+        }
+        if (!changed) continue;
+
+        for (int ny : { ry - 1, ry + 1 }) {
+            if (ny >= 0 && ny < height && !queued[ny]) {
+                queued[ny] = 1;
+                pending.push_back(ny);
+            }
+        }
+    }
+    return result;
+}
+
+int Bitboard::count() const {
+    int total = 0;
+    for (std::uint64_t word : bits) {
+        total += popcount64(word);
+    }
+    return total;
+}
+
+// Skips whole words by popcount, then clears low bits inside the last one
+bool Bitboard::select(int n, int& x, int& y) const {
+    if (n < 0) return false;
+    for (int ry = 0; ry < height; ry++) {
+        const std::uint64_t* words = row(ry);
+        for (int word = 0; word < wordsPerRow; word++) {
+            int inWord = popcount64(words[word]);
+            if (n >= inWord) {
+                n -= inWord;
+                continue;
+            }
+
+            std::uint64_t remaining = words[word];
+            for (; n > 0; n--) {
+                remaining &= remaining - 1;
+            }
+            x = word * 64 + trailingZeros64(remaining);
+            y = ry;
+            return true;
+        }
+    }
+    return false;
+}
+
+int Bitboard::nextSet(int y, int x) const {
+    if (x >= width) return width;
+    const std::uint64_t* words = row(y);
+    int word = x >> 6;
+    std::uint64_t remaining = words[word] & (~std::uint64_t(0) << (x & 63));
+    while (remaining == 0) {
+        if (++word == wordsPerRow) return width;
+        remaining = words[word];
+    }
+    return std::min(width, word * 64 + trailingZeros64(remaining));
+}
+
+int Bitboard::nextClear(int y, int x) const {
+    if (x >= width) return width;
+    const std::uint64_t* words = row(y);
+    int word = x >> 6;
+    std::uint64_t remaining = ~words[word] & (~std::uint64_t(0) << (x & 63));
+    while (remaining == 0) {
+        if (++word == wordsPerRow) return width;
+        remaining = ~words[word];
+    }
+    return std::min(width, word * 64 + trailingZeros64(remaining));
+}
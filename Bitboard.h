@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One bit per tile (set = walkable), 64 tiles per word, rows padded to whole
+// words. Fills and stats work on full words instead of tiles.
+class Bitboard {
+public:
+    Bitboard() = default;
+    Bitboard(int width, int height);
+
+    // Walkable (0) tiles of a generator grid
+    static Bitboard fromGrid(const std::vector<std::vector<int>>& grid);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    const std::uint64_t* row(int y) const { return bits.data() + static_cast<size_t>(y) * wordsPerRow; }
+
+    bool get(int x, int y) const;
+    void set(int x, int y, bool value);
+
+    // Inclusive span of one row, clipped to the board
+    void fillSpan(int y, int x0, int x1);
+
+    // Set tiles 4-connected to (x, y); empty when (x, y) is not set
+    Bitboard floodFill(int x, int y) const;
+
+    // Popcount stats
+    int count() const;
+    // Position of the n-th set tile in row-major order (0-based); false when
+    // fewer than n + 1 tiles are set. Uniform picks are select(range(0, count - 1)).
+    bool select(int n, int& x, int& y) const;
+
+    // First set / unset tile at or after x in a row, width when none
+    int nextSet(int y, int x) const;
+    int nextClear(int y, int x) const;
+
+    // Calls visit(x0, x1) for every inclusive run of set tiles in a row
+    template <typename Visit>
+    void forEachRun(int y, Visit visit) const {
+        int x = nextSet(y, 0);
+        while (x < width) {
+            int end = nextClear(y, x);
+            visit(x, end - 1);
+            x = nextSet(y, end);
+        }
+    }
+
+private:
+    int width = 0;
+    int height = 0;
+    int wordsPerRow = 0;
+    std::vector<std::uint64_t> bits;
+
+    std::uint64_t* row(int y) { return bits.data() + static_cast<size_t>(y) * wordsPerRow; }
+    void fillRow(std::uint64_t* target, const std::uint64_t* mask) const;
+};
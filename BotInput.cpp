@@ -0,0 +1,91 @@
+#include "BotInput.h"
+#include "Pathfinder.h"
+#include <cmath>
+
+PlayerInput BotInput::read(const InputContext& context) {
+    PlayerInput input;
+    sf::Vector2f position = context.player.getPosition();
+    input.aim = position;
+
+    // A new level moves the exit; otherwise refresh now and then since the
+    // player gets pushed around by walls and enemies
+    repathTimer += context.deltaTime;
+    if (context.exitCenter != pathExit || repathTimer >= repathInterval) {
+        planPath(context);
+    }
+
+    // No progress for a while: probably caught on a corner, plan again
+    stuckTimer += context.deltaTime;
+    sf::Vector2f moved = position - lastProgressPosition;
+    if (std::abs(moved.x) + std::abs(moved.y) > context.tileSize * 0.5f) {
+        lastProgressPosition = position;
+        stuckTimer = 0.f;
+    }
+    else if (stuckTimer >= stuckInterval) {
+        stuckTimer = 0.f;
+        planPath(context);
+    }
+
+    // Waypoints are tile centres; the last one is the exit tile itself
+    while (nextWaypoint < path.size()) {
+        sf::Vector2i tile = path[nextWaypoint];
+        sf::Vector2f waypoint((tile.x + 0.5f) * context.tileSize, (tile.y + 0.5f) * context.tileSize);
+        sf::Vector2f offset = waypoint - position;
+        if (std::abs(offset.x) <= arriveDistance && std::abs(offset.y) <= arriveDistance) {
+            nextWaypoint++;
+            continue;
+        }
+
+        input.left = offset.x < -arriveDistance;
+        input.right = offset.x > arriveDistance;
+        input.up = offset.y < -arriveDistance;
+        input.down = offset.y > arriveDistance;
+        input.aim = waypoint;
+        break;
+    }
+
+    if (const Enemy* target = pickTarget(context)) {
+        input.aim = target->getPosition();
+        input.attack = true;
+    }
+    return input;
+}
+
+void BotInput::restart() {
+    path.clear();
+    nextWaypoint = 0;
+    pathExit = { -1.f, -1.f };
+    repathTimer = 0.f;
+    stuckTimer = 0.f;
+}
+
+void BotInput::planPath(const InputContext& context) {
+    repathTimer = 0.f;
+    pathExit = context.exitCenter;
+    nextWaypoint = 0;
+
+    sf::Vector2f position = context.player.getPosition();
+    sf::Vector2i start(static_cast<int>(position.x / context.tileSize), static_cast<int>(position.y / context.tileSize));
+    sf::Vector2i exitTile(static_cast<int>(context.exitCenter.x / context.tileSize),
+        static_cast<int>(context.exitCenter.y / context.tileSize));
+    Pathfinder::findPath(context.maze, start, exitTile, path, &context.regions);
+}
+
+// Closest living enemy in range with a clear line of fire
+const Enemy* BotInput::pickTarget(const InputContext& context) const {
+    sf::Vector2f position = context.player.getPosition();
+    const Enemy* best = nullptr;
+    float bestDistance = attackRange * attackRange;
+
+    for (const auto& enemy : context.enemies) {
+        if (!enemy->isAlive()) continue;
+        sf::Vector2f offset = enemy->getPosition() - position;
+        float distance = offset.x * offset.x + offset.y * offset.y;
+        if (distance >= bestDistance) continue;
+        if (!context.occupancy.segmentClear(position / context.tileSize, enemy->getPosition() / context.tileSize)) continue;
+
+        best = enemy.get();
+        bestDistance = distance;
+    }
+    return best;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "InputSource.h"
+
+// Autopilot for soak and performance runs: walks the shortest tile path to
+// the exit and fires bolts at the nearest enemy it can see. Not meant to
+// be good at the game, only to keep every system busy without a person.
+class BotInput : public InputSource {
+public:
+    PlayerInput read(const InputContext& context) override;
+    void restart() override;
+
+private:
+    static constexpr float repathInterval = 0.5f;
+    static constexpr float attackRange = 300.f;
+    static constexpr float arriveDistance = 4.f;  // pixels from a waypoint centre
+    static constexpr float stuckInterval = 1.f;   // seconds without progress
+
+    std::vector<sf::Vector2i> path;
+    size_t nextWaypoint = 0;
+    sf::Vector2f pathExit{ -1.f, -1.f }; // exit the path leads to
+    float repathTimer = 0.f;
+
+    sf::Vector2f lastProgressPosition;
+    float stuckTimer = 0.f;
+
+    void planPath(const InputContext& context);
+    const Enemy* pickTarget(const InputContext& context) const;
+};
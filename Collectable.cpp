@@ -67,10 +67,10 @@ void Collectable::update(float deltaTime) {
     if (lifeTime <= 0.f) collected = true;
 }
 
-void Collectable::draw(sf::RenderWindow& window) const {
+void Collectable::draw(RenderSnapshot& frame) const {
     if (!collected) {
-        window.draw(pulseShape);
-        window.draw(shape);
+        frame.draw(pulseShape);
+        frame.draw(shape);
 
         // Draw icon based on type (would need texture)
     }
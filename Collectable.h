@@ -3,6 +3,7 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <memory>
+#include "RenderSnapshot.h"
 
 class Player; // Forward declaration
 
@@ -18,7 +19,7 @@ public:
 
     Collectable(sf::Vector2f position, Type type, float value);
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window) const;
+    void draw(RenderSnapshot& frame) const;
     sf::FloatRect getBounds() const;
     Type getType() const { return type; }
     float getValue() const { return value; }
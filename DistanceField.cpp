@@ -0,0 +1,181 @@
+#include "DistanceField.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    const float unreached = 1e20f;
+    const int rowsPerBand = 64;
+
+    // Squared distance transform of one line: d[q] = min over p of (q - p)^2 + f[p].
+    // Lower envelope of the parabolas rooted at every p; v and z are scratch.
+    void transformLine(const float* f, int n, float* d, int* v, float* z) {
+        const float infinity = std::numeric_limits<float>::infinity();
+        int k = 0;
+        v[0] = 0;
+        z[0] = -infinity;
+        z[1] = infinity;
+        for (int q = 1; q < n; q++) {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * (q - v[k]));
+            while (s <= z[k]) {
+                k--;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * (q - v[k]));
+            }
+            k++;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = infinity;
+        }
+
+        k = 0;
+        for (int q = 0; q < n; q++) {
+            while (z[k + 1] < q) k++;
+            float offset = static_cast<float>(q - v[k]);
+            d[q] = offset * offset + f[v[k]];
+        }
+    }
+
+    // 2D squared distance to the nearest source (0 in grid, unreached elsewhere).
+    // The column pass is a two-way scan over whole rows, which keeps memory
+    // access sequential; rows then take the exact parabola envelope.
+    void transform(std::vector<float>& grid, int width, int height, JobSystem& jobs) {
+        for (int y = 1; y < height; y++) {
+            float* row = grid.data() + static_cast<size_t>(y) * width;
+            const float* above = row - width;
+            for (int x = 0; x < width; x++) {
+                row[x] = std::min(row[x], above[x] + 1.f);
+            }
+        }
+        for (int y = height - 2; y >= 0; y--) {
+            float* row = grid.data() + static_cast<size_t>(y) * width;
+            const float* below = row + width;
+            for (int x = 0; x < width; x++) {
+                row[x] = std::min(row[x], below[x] + 1.f);
+            }
+        }
+        for (float& value : grid) {
+            if (value < unreached) value *= value;
+        }
+
+        // Rows are independent: spread bands of them over the pool
+        int bands = (height + rowsPerBand - 1) / rowsPerBand;
+        jobs.parallelFor(bands, [&](int band) {
+            std::vector<float> result(width);
+            std::vector<int> v(width);
+            std::vector<float> z(width + 1);
+            int last = std::min(height, (band + 1) * rowsPerBand);
+            for (int y = band * rowsPerBand; y < last; y++) {
+                float* row = grid.data() + static_cast<size_t>(y) * width;
+                transformLine(row, width, result.data(), v.data(), z.data());
+                std::copy(result.begin(), result.end(), row);
+            }
+        });
+    }
+}
+
+// Distances to the nearest wall centre (for floor) and nearest floor centre
+// (for walls); the boundary sits half a tile short of either. The window
+// reaches one tile past the map on every side so the outside counts as solid.
+void DistanceField::build(const Bitboard& floor, JobSystem& jobs) {
+    PROFILE_SCOPE("DistanceField::build");
+    width = floor.getWidth();
+    height = floor.getHeight();
+    values.assign(static_cast<size_t>(width) * height, 0);
+
+    Window window{ -1, -1, width + 2, height + 2 };
+    std::vector<float> toWall(static_cast<size_t>(window.width) * window.height, 0.f);
+    std::vector<float> toFloor(toWall.size(), unreached);
+    for (int y = 0; y < height; y++) {
+        size_t rowStart = static_cast<size_t>(y + 1) * window.width + 1;
+        floor.forEachRun(y, [&](int x0, int x1) {
+            std::fill(toWall.begin() + rowStart + x0, toWall.begin() + rowStart + x1 + 1, unreached);
+            std::fill(toFloor.begin() + rowStart + x0, toFloor.begin() + rowStart + x1 + 1, 0.f);
+        });
+    }
+    solve(window, toWall, toFloor, { 0, 0, width - 1, height - 1 }, jobs);
+}
+
+// Values are capped at maxRange, so an edit can only change tiles within
+// that range of it, and those only depend on sources within twice the range
+void DistanceField::onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) {
+    if (tiles.getWidth() != width || tiles.getHeight() != height) {
+        build(tiles.walkable());
+        return;
+    }
+
+    TileMap::TileRect out{
+        std::max(0, area.x0 - maxRange), std::max(0, area.y0 - maxRange),
+        std::min(width - 1, area.x1 + maxRange), std::min(height - 1, area.y1 + maxRange)
+    };
+    if (out.x0 > out.x1 || out.y0 > out.y1) return;
+
+    int x0 = std::max(-1, out.x0 - maxRange);
+    int y0 = std::max(-1, out.y0 - maxRange);
+    int x1 = std::min(width, out.x1 + maxRange);
+    int y1 = std::min(height, out.y1 + maxRange);
+    Window window{ x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+
+    std::vector<float> toWall(static_cast<size_t>(window.width) * window.height, 0.f);
+    std::vector<float> toFloor(toWall.size(), unreached);
+    for (int y = 0; y < window.height; y++) {
+        for (int x = 0; x < window.width; x++) {
+            if (tiles.isWall(window.x + x, window.y + y)) continue;
+            size_t index = static_cast<size_t>(y) * window.width + x;
+            toWall[index] = unreached;
+            toFloor[index] = 0.f;
+        }
+    }
+    solve(window, toWall, toFloor, out, JobSystem::shared());
+}
+
+// Transforms both source grids of a window and stores the capped signed
+// distances of the tiles in out
+void DistanceField::solve(const Window& window, std::vector<float>& toWall, std::vector<float>& toFloor,
+    const TileMap::TileRect& out, JobSystem& jobs) {
+    transform(toWall, window.width, window.height, jobs);
+    transform(toFloor, window.width, window.height, jobs);
+
+    float limit = static_cast<float>(maxRange);
+    for (int y = out.y0; y <= out.y1; y++) {
+        for (int x = out.x0; x <= out.x1; x++) {
+            size_t index = static_cast<size_t>(y - window.y) * window.width + (x - window.x);
+            float distance = toFloor[index] == 0.f
+                ? std::sqrt(toWall[index]) - 0.5f
+                : 0.5f - std::sqrt(toFloor[index]);
+            distance = std::max(-limit, std::min(limit, distance));
+            values[static_cast<size_t>(y) * width + x] = static_cast<std::int16_t>(std::round(distance * scale));
+        }
+    }
+}
+
+float DistanceField::at(int x, int y) const {
+    if (values.empty()) return 0.f;
+    x = std::max(0, std::min(width - 1, x));
+    y = std::max(0, std::min(height - 1, y));
+    return values[static_cast<size_t>(y) * width + x] / scale;
+}
+
+float DistanceField::sample(sf::Vector2f position) const {
+    // Tile centres sit at half-tile offsets
+    float fx = position.x - 0.5f;
+    float fy = position.y - 0.5f;
+    int x0 = static_cast<int>(std::floor(fx));
+    int y0 = static_cast<int>(std::floor(fy));
+    float tx = fx - x0;
+    float ty = fy - y0;
+
+    float top = at(x0, y0) + (at(x0 + 1, y0) - at(x0, y0)) * tx;
+    float bottom = at(x0, y0 + 1) + (at(x0 + 1, y0 + 1) - at(x0, y0 + 1)) * tx;
+    return top + (bottom - top) * ty;
+}
+
+sf::Vector2f DistanceField::gradient(sf::Vector2f position) const {
+    const float step = 0.5f;
+    sf::Vector2f slope(
+        sample({ position.x + step, position.y }) - sample({ position.x - step, position.y }),
+        sample({ position.x, position.y + step }) - sample({ position.x, position.y - step }));
+
+    float length = std::sqrt(slope.x * slope.x + slope.y * slope.y);
+    return length > 0.f ? slope / length : sf::Vector2f(0.f, 0.f);
+}
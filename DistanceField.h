@@ -0,0 +1,54 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "JobSystem.h"
+#include "TileMap.h"
+
+// Signed distance from every tile centre to the nearest wall/floor boundary,
+// in tiles: positive on floor, negative inside walls, capped at maxRange.
+// Built once per level with an exact Euclidean distance transform
+// (Felzenszwalb-Huttenlocher, separable rows then columns) and stored as
+// 16-bit fixed point.
+// Positions below are in tile units, so a world position is divided by the
+// tile size first.
+class DistanceField : public TileMap::Listener {
+public:
+    static const int maxRange = 16;
+
+    void build(const Bitboard& floor, JobSystem& jobs = JobSystem::shared());
+    // Recomputes the tiles within maxRange of the edit
+    void onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) override;
+
+    bool empty() const { return values.empty(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Heap bytes held, two per tile
+    size_t memoryUsage() const { return values.capacity() * sizeof(std::int16_t); }
+
+    // Distance at a tile centre
+    float at(int x, int y) const;
+    // Bilinear between tile centres; outside the map reads as the edge
+    float sample(sf::Vector2f position) const;
+    // Unit vector pointing away from the nearest wall, zero on flat ground
+    sf::Vector2f gradient(sf::Vector2f position) const;
+
+private:
+    static constexpr float scale = 64.f; // fixed point steps per tile
+
+    int width = 0;
+    int height = 0;
+    std::vector<std::int16_t> values;
+
+    // Part of the map the sources are read from; may extend one tile
+    // outside it
+    struct Window {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+    void solve(const Window& window, std::vector<float>& toWall, std::vector<float>& toFloor,
+        const TileMap::TileRect& out, JobSystem& jobs);
+};
@@ -1,15 +1,21 @@
 #include "Enemy.h"
 #include "Player.h"
+#include "RegionMap.h"
+#include "DistanceField.h"
+#include "OccupancyPyramid.h"
+#include "Log.h"
+#include "Pathfinder.h"
+#include "Profiler.h"
+#include "Steering.h"
 #include <cmath>
-#include <iostream>
 #include <algorithm>
 
 
 
 // Projectile implementation
-Enemy::Projectile::Projectile(sf::Vector2f pos, sf::Vector2f dir, float spd, float dmg, const sf::Texture& tex)
+Enemy::Projectile::Projectile(sf::Vector2f pos, sf::Vector2f dir, float spd, float dmg, const sf::Texture* tex)
     : direction(dir), speed(spd), damage(dmg), lifetime(0.f) {
-    sprite.setTexture(tex);
+    TextureCache::apply(sprite, tex);
     sprite.setOrigin(4.f, 3.f);
     sprite.setPosition(pos);
     collisionBox = sf::FloatRect(pos.x - 3.f, pos.y - 2.f, 6.f, 4.f);
@@ -35,26 +41,27 @@ Enemy::Enemy(sf::Vector2f position, float health,EnemyType type)
     loadShriekTextures();
     loadBulletAssets();
     // Load bullet texture
-    if (!bulletTexture.loadFromFile("assets/bullet.png")) {
-        std::cerr << "Failed to load bullet texture\n";
-    }
+    bulletTexture = TextureCache::get("assets/bullet.png");
     // Load sound buffer
     if (!bulletSoundBuffer.loadFromFile("assets/bullet.wav")) {
-        std::cerr << "Failed to load bullet sound\n";
+        LOG_ERROR(Log::Assets, "Failed to load bullet sound");
     }
     bulletSound.setBuffer(bulletSoundBuffer);
     // Initialize sprite with first idle frame if available
     if (!idleTextures.empty()) {
-        sprite.setTexture(idleTextures[0]);
+        TextureCache::apply(sprite, idleTextures[0]);
+        // Sizes the sprite (and so the collision box) even without textures
+        sprite.setTextureRect(sf::IntRect(0, 0, frameSize.x, frameSize.y));
         float scaleFactor = 2.0f;
         sprite.setScale(scaleFactor, scaleFactor);
-        sprite.setOrigin(idleTextures[0].getSize().x / 2.f, idleTextures[0].getSize().y / 2.f);
+        sprite.setOrigin(frameSize.x / 2.f, frameSize.y / 2.f);
         sprite.setPosition(position);
     }
     else {
-        std::cerr << "Warning: Failed to load enemy textures\n";
+        LOG_WARN(Log::Assets, "Failed to load enemy textures");
         sprite.setPosition(position);
     }
+    previousPosition = position;
 
     updateCollisionBox();
     collisionDebug.setSize(sf::Vector2f(collisionBox.width, collisionBox.height));
@@ -81,8 +88,9 @@ Enemy::~Enemy() {
 }
 
 // uodates enemy stuff
-void Enemy::update(float deltaTime, const std::vector<std::vector<int>>& maze,
+void Enemy::update(float deltaTime, const TileMap& maze,
     float tileSize, const std::vector<Enemy*>& otherEnemies) {
+    PROFILE_SCOPE("Enemy::update");
     if (!alive) return;
 
     updateHPBar();
@@ -118,8 +126,11 @@ void Enemy::update(float deltaTime, const std::vector<std::vector<int>>& maze,
                 );
             }
 
-            // Check if player is in range for attack
-            if (distanceToPlayer <= attackRange && attackTimer >= attackCooldown) {
+            // Check if player is in range and not behind a wall; the sight
+            // line is only cast once range and cooldown allow a shot
+            bool canAttack = distanceToPlayer <= attackRange && attackTimer >= attackCooldown;
+            if (canAttack && (!occupancy ||
+                occupancy->segmentClear(sprite.getPosition() / tileSize, player->getPosition() / tileSize))) {
                 attackPlayer();
                 attackTimer = 0.0f;
             }
@@ -149,46 +160,21 @@ void Enemy::update(float deltaTime, const std::vector<std::vector<int>>& maze,
     }
 }
 //path finder
-sf::Vector2f Enemy::calculateSteeringForce(const std::vector<std::vector<int>>& maze, float tileSize, const std::vector<Enemy*>& otherEnemies) {
-    sf::Vector2f force(0, 0);
-    if (!player) return force;
-
-    // Seek player
-    sf::Vector2f toPlayer = player->getPosition() - sprite.getPosition();
-    float distance = std::sqrt(toPlayer.x * toPlayer.x + toPlayer.y * toPlayer.y);
-    if (distance > 0) {
-        force += (toPlayer / distance) * 1.5f;
-    }
-
-    // Follow path
-    if (!currentPath.empty()) {
-        sf::Vector2f toWaypoint = currentPath.back() - sprite.getPosition();
-        float wpDistance = std::sqrt(toWaypoint.x * toWaypoint.x + toWaypoint.y * toWaypoint.y);
-        if (wpDistance > 0) {
-            force += (toWaypoint / wpDistance) * 1.2f;
-            if (wpDistance < 10.f) {
-                currentPath.pop_back();
-            }
-        }
-    }
+sf::Vector2f Enemy::calculateSteeringForce(const TileMap& maze, float tileSize, const std::vector<Enemy*>& otherEnemies) {
+    if (!player) return sf::Vector2f(0, 0);
 
-    // Avoid other enemies
-    for (const Enemy* other : otherEnemies) {
-        if (other == this || !other->isAlive()) continue;
+    const sf::Vector2f* waypoint = currentPath.empty() ? nullptr : &currentPath.back();
+    sf::Vector2f force = Steering::force(sprite.getPosition(), player->getPosition(), waypoint,
+        otherEnemies, this, wallField, tileSize, avoidanceRadius, wallAvoidance);
 
-        sf::Vector2f away = sprite.getPosition() - other->getPosition();
-        float dist = std::sqrt(away.x * away.x + away.y * away.y);
-        if (dist < avoidanceRadius && dist > 0) {
-            force += (away / dist) * (1.0f - dist / avoidanceRadius) * 2.0f;
+    // Move on to the next waypoint once this one is reached
+    if (waypoint) {
+        sf::Vector2f toWaypoint = *waypoint - sprite.getPosition();
+        float wpDistance = std::sqrt(toWaypoint.x * toWaypoint.x + toWaypoint.y * toWaypoint.y);
+        if (wpDistance > 0 && wpDistance < 10.f) {
+            currentPath.pop_back();
         }
     }
-
-    // Normalize
-    float forceLength = std::sqrt(force.x * force.x + force.y * force.y);
-    if (forceLength > 0) {
-        force /= forceLength;
-    }
-
     return force;
 }
 
@@ -323,18 +309,15 @@ void Enemy::setType(EnemyType type) {
     attackCooldown /= attackSpeedModifier;
 }
 //randomly pics a type
-Enemy::EnemyType Enemy::getRandomType() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, 3);
-
-    int type = dis(gen);
+Enemy::EnemyType Enemy::getRandomType(Rng& rng) {
+    int type = rng.range(0, 3);
     return static_cast<EnemyType>(type);
 }
 
 //accurately follows player
-void Enemy::updatePathfinding(const std::vector<std::vector<int>>& maze, float tileSize) {
-    if (!player || maze.empty()) return;
+void Enemy::updatePathfinding(const TileMap& maze, float tileSize) {
+    PROFILE_SCOPE("Enemy::updatePathfinding");
+    if (!player || maze.getWidth() == 0) return;
 
     sf::Vector2i start(
         static_cast<int>(sprite.getPosition().x / tileSize),
@@ -345,63 +328,15 @@ void Enemy::updatePathfinding(const std::vector<std::vector<int>>& maze, float t
         static_cast<int>(player->getPosition().y / tileSize)
     );
 
-    auto heuristic = [](sf::Vector2i a, sf::Vector2i b) {
-        return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
-        };
-
-    std::priority_queue<PathNode, std::vector<PathNode>, std::greater<PathNode>> openSet;
-    std::vector<std::vector<bool>> closedSet(maze.size(), std::vector<bool>(maze[0].size(), false));
-    std::vector<std::vector<PathNode>> nodeInfo(maze.size(), std::vector<PathNode>(maze[0].size()));
-
-    PathNode startNode = { start, 0.f, heuristic(start, target), {-1, -1} };
-    openSet.push(startNode);
-    nodeInfo[start.y][start.x] = startNode;
-
-    while (!openSet.empty()) {
-        PathNode current = openSet.top();
-        openSet.pop();
-
-        if (current.pos == target) {
-            currentPath.clear();
-            sf::Vector2i pathNode = target;
-            while (pathNode != start) {
-                currentPath.emplace_back(
-                    (pathNode.x + 0.5f) * tileSize,
-                    (pathNode.y + 0.5f) * tileSize
-                );
-                pathNode = nodeInfo[pathNode.y][pathNode.x].parent;
-            }
-            std::reverse(currentPath.begin(), currentPath.end());
-            return;
-        }
-
-        closedSet[current.pos.y][current.pos.x] = true;
-
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                if (dx == 0 || dy == 0) { // Cardinal directions only
-                    sf::Vector2i neighbor(current.pos.x + dx, current.pos.y + dy);
-
-                    if (neighbor.x >= 0 && neighbor.y >= 0 &&
-                        neighbor.x < static_cast<int>(maze[0].size()) &&
-                        neighbor.y < static_cast<int>(maze.size()) &&
-                        maze[neighbor.y][neighbor.x] == 0) {
-
-                        float moveCost = current.cost + 1.0f;
-                        float newHeuristic = heuristic(neighbor, target);
-
-                        if (!closedSet[neighbor.y][neighbor.x] &&
-                            (nodeInfo[neighbor.y][neighbor.x].parent == sf::Vector2i(-1, -1) ||
-                                moveCost < nodeInfo[neighbor.y][neighbor.x].cost)) {
+    std::vector<sf::Vector2i> tiles;
+    if (!Pathfinder::findPath(maze, start, target, tiles, regionMap)) {
+        currentPath.clear();
+        return;
+    }
 
-                            PathNode neighborNode = { neighbor, moveCost, newHeuristic, current.pos };
-                            nodeInfo[neighbor.y][neighbor.x] = neighborNode;
-                            openSet.push(neighborNode);
-                        }
-                    }
-                }
-            }
-        }
+    currentPath.clear();
+    for (sf::Vector2i tile : tiles) {
+        currentPath.emplace_back((tile.x + 0.5f) * tileSize, (tile.y + 0.5f) * tileSize);
     }
 }
 
@@ -432,23 +367,44 @@ float Enemy::getHealth() const {
 void Enemy::setPlayer(Player* p) {
     player = p;
 }
+void Enemy::setRegionMap(const RegionMap* map) {
+    regionMap = map;
+}
+
+void Enemy::setWallField(const DistanceField* field) {
+    wallField = field;
+}
+
+void Enemy::setOccupancy(const OccupancyPyramid* pyramid) {
+    occupancy = pyramid;
+}
 //draws enemy stuffs
-void Enemy::draw(sf::RenderWindow& window) {
+void Enemy::draw(RenderSnapshot& frame, float alpha) {
+    // Shift the body to its interpolated position just for drawing
+    sf::Vector2f shift = getRenderPosition(alpha) - sprite.getPosition();
+    sprite.move(shift);
+    hpBarBackground.move(shift);
+    hpBarFill.move(shift);
+
     if (alive) {
 		//apply color to sprite
         sprite.setColor(enemyColor);
-        window.draw(sprite);
+        frame.draw(sprite);
     }
     // Draw HP bar if visible and enemy is alive
     if (showHPBar) {
-        window.draw(hpBarBackground);
-        window.draw(hpBarFill);
+        frame.draw(hpBarBackground);
+        frame.draw(hpBarFill);
     }
 
+    sprite.move(-shift);
+    hpBarBackground.move(-shift);
+    hpBarFill.move(-shift);
+
 
     // Draw projectiles
     for (auto& projectile : projectiles) {
-        window.draw(projectile.sprite);
+        frame.draw(projectile.sprite);
 
         if (showDebug) {
             // Draw projectile collision box
@@ -458,7 +414,7 @@ void Enemy::draw(sf::RenderWindow& window) {
             ));
             debugRect.setPosition(projectile.collisionBox.left, projectile.collisionBox.top);
             debugRect.setFillColor(sf::Color(255, 255, 0, 100));
-            window.draw(debugRect);
+            frame.draw(debugRect);
         }
     }
 }
@@ -472,6 +428,10 @@ sf::Vector2f Enemy::getPosition() const
 	return sprite.getPosition();
 }
 
+sf::Vector2f Enemy::getRenderPosition(float alpha) const {
+    return previousPosition + (sprite.getPosition() - previousPosition) * alpha;
+}
+
 void Enemy::setPosition(const sf::Vector2f& position)
 {
     sprite.setPosition(position);
@@ -484,7 +444,7 @@ void Enemy::toggleDebug(bool debug)
 	showDebug = debug;
 }
 
-void Enemy::drawDebug(sf::RenderWindow& window) const {
+void Enemy::drawDebug(RenderSnapshot& frame) const {
     if (!showDebug) return;
 
     // Draw collision box
@@ -494,7 +454,7 @@ void Enemy::drawDebug(sf::RenderWindow& window) const {
     ));
     debugRect.setPosition(collisionBox.left, collisionBox.top);
     debugRect.setFillColor(sf::Color(255, 0, 0, 100)); // Semi-transparent red
-    window.draw(debugRect);
+    frame.draw(debugRect);
 
     // Draw path if available
     if (!currentPath.empty()) {
@@ -507,7 +467,7 @@ void Enemy::drawDebug(sf::RenderWindow& window) const {
             pathLines[i + 1].color = sf::Color::Green;
         }
 
-        window.draw(pathLines);
+        frame.draw(pathLines);
     }
 }
 //disables collision when dead
@@ -518,17 +478,10 @@ void Enemy::disableCollision()
 //texture and animation stuff
 void Enemy::loadShriekTextures()
 {
-    sf::Texture sheet;
-    if (!sheet.loadFromFile("assets/ghost-shriek.png")) {
-        std::cerr << "Failed to load ghost-shriek spritesheet\n";
-        return;
-    }
-
-    // Split 256x80 sheet into 4 frames (each 64x80)
-    for (int i = 0; i < 4; ++i) {
-        sf::Texture frame;
-        frame.loadFromImage(sheet.copyToImage(), sf::IntRect(i * 64, 0, 64, 80));
-        shriekTextures.push_back(frame);
+    // 256x80 sheet, 4 frames
+    shriekTextures = TextureCache::sheet("assets/ghost-shriek.png", 4, frameSize);
+    if (shriekTextures.empty()) {
+        LOG_ERROR(Log::Assets, "Failed to load ghost-shriek spritesheet");
     }
 }
 
@@ -546,56 +499,31 @@ void Enemy::updateShriekAnimation(float deltaTime)
             currentFrame = 0;
         }
         else {
-            sprite.setTexture(shriekTextures[currentFrame]);
+            TextureCache::apply(sprite, shriekTextures[currentFrame]);
         }
     }
 }
 
 void Enemy::loadBulletAssets()
 {
-    sf::Texture sheet;
-    if (!sheet.loadFromFile("assets/ghost-shriek.png")) {
-        std::cerr << "Failed to load ghost-shriek spritesheet\n";
-        return;
-    }
-
-    // Split 256x80 sheet into 4 frames (each 64x80)
-    for (int i = 0; i < 4; ++i) {
-        sf::Texture frame;
-        frame.loadFromImage(sheet.copyToImage(), sf::IntRect(i * 64, 0, 64, 80));
-        shriekTextures.push_back(frame);
-    }
+    const auto& sheet = TextureCache::sheet("assets/ghost-shriek.png", 4, frameSize);
+    shriekTextures.insert(shriekTextures.end(), sheet.begin(), sheet.end());
 }
 
 void Enemy::loadIdleTextures()
 {
-    sf::Texture sheet;
-    if (!sheet.loadFromFile("assets/ghost-idle.png")) {
-        std::cerr << "Failed to load ghost-idle spritesheet\n";
-        return;
-    }
-
-    // Split 448x80 sheet into 7 frames (each 64x80)
-    for (int i = 0; i < 7; ++i) {
-        sf::Texture frame;
-        frame.loadFromImage(sheet.copyToImage(), sf::IntRect(i * 64, 0, 64, 80));
-        idleTextures.push_back(frame);
+    // 448x80 sheet, 7 frames
+    idleTextures = TextureCache::sheet("assets/ghost-idle.png", 7, frameSize);
+    if (idleTextures.empty()) {
+        LOG_ERROR(Log::Assets, "Failed to load ghost-idle spritesheet");
     }
 }
 
 void Enemy::loadVanishTextures()
 {
-    sf::Texture sheet;
-    if (!sheet.loadFromFile("assets/ghost-vanish.png")) {
-        std::cerr << "Failed to load ghost-vanish spritesheet\n";
-        return;
-    }
-
-    // Assuming similar dimensions - adjust as needed
-    for (int i = 0; i < 7; ++i) { 
-        sf::Texture frame;
-        frame.loadFromImage(sheet.copyToImage(), sf::IntRect(i * 64, 0, 64, 80));
-        vanishTextures.push_back(frame);
+    vanishTextures = TextureCache::sheet("assets/ghost-vanish.png", 7, frameSize);
+    if (vanishTextures.empty()) {
+        LOG_ERROR(Log::Assets, "Failed to load ghost-vanish spritesheet");
     }
 }
 
@@ -605,7 +533,7 @@ void Enemy::updateIdleAnimation(float deltaTime)
     if (animationTimer >= frameDuration && !idleTextures.empty()) {
         animationTimer = 0.f;
         currentFrame = (currentFrame + 1) % idleTextures.size();
-        sprite.setTexture(idleTextures[currentFrame]);
+        TextureCache::apply(sprite, idleTextures[currentFrame]);
     }
 }
 
@@ -616,7 +544,7 @@ void Enemy::updateVanishAnimation(float deltaTime)
     int frame = static_cast<int>(vanishTimer / frameTime);
 
     if (frame < vanishTextures.size()) {
-        sprite.setTexture(vanishTextures[frame]);
+        TextureCache::apply(sprite, vanishTextures[frame]);
     }
     else {
         currentState = State::DEAD;
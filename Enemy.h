@@ -6,9 +6,19 @@
 #include <queue>
 #include <functional>
 #include <random>
+#include "RenderSnapshot.h"
+#include "TextureCache.h"
+#include "Rng.h"
+#include "Steering.h"
+#include "TileMap.h"
 class Player;
+class RegionMap;
+class DistanceField;
+class OccupancyPyramid;
 
 class Enemy {
+    //foreward declaratrion of projectile
+	struct Projectile;
 public:
     enum EnemyType {
         BASIC,
@@ -19,8 +29,6 @@ public:
 
     Enemy(sf::Vector2f position, float health, EnemyType type);
     ~Enemy();
-    //foreward declaratrion of projectile
-	struct Projectile;
     enum class State { IDLE, VANISHING, DEAD, ATTACKING };
 
     float lifetime;  // Add lifetime tracking
@@ -31,16 +39,21 @@ public:
     Enemy& operator=(const Enemy&) = delete;
 
     // Movement and combat
-    void update(float deltaTime, const std::vector<std::vector<int>>& maze,
+    void update(float deltaTime, const TileMap& maze,
         float tileSize, const std::vector<Enemy*>& otherEnemies);
     void takeDamage(float damage);
     bool isAlive() const;
     float getHealth() const;
     void setPlayer(Player* p);
+    void setRegionMap(const RegionMap* map);
+    void setWallField(const DistanceField* field);
+    void setOccupancy(const OccupancyPyramid* pyramid);
 
 
     // Projectile control methods
     const std::vector<Projectile>& getProjectiles() const { return projectiles; }
+    // Every enemy holds its own copy of the bullet sound
+    std::size_t soundBytes() const { return bulletSoundBuffer.getSampleCount() * sizeof(sf::Int16); }
     
 
     // Projectile parameter setters
@@ -51,10 +64,15 @@ public:
 
 
 
+    // Interpolation between simulation steps: the game saves the position
+    // before each step and draws a blend of the last two
+    void savePreviousPosition() { previousPosition = sprite.getPosition(); }
+    sf::Vector2f getRenderPosition(float alpha) const;
+
     // Rendering
-    void draw(sf::RenderWindow& window);
+    void draw(RenderSnapshot& frame, float alpha = 1.f);
     void toggleDebug(bool debug);
-    void drawDebug(sf::RenderWindow& window) const;
+    void drawDebug(RenderSnapshot& frame) const;
 
     // Collision
     sf::FloatRect getCollisionBox() const;
@@ -68,7 +86,7 @@ public:
 
 
     void setType(EnemyType type);
-    static EnemyType getRandomType();
+    static EnemyType getRandomType(Rng& rng);
 
     void setMovementSpeed(float speed) { baseSpeed = speed; }
 private:
@@ -96,7 +114,7 @@ private:
         sf::FloatRect collisionBox;
         float lifetime = 0.f;
         float maxLifetime = 2.0f;
-        Projectile(sf::Vector2f pos, sf::Vector2f dir, float spd, float dmg, const sf::Texture& tex);
+        Projectile(sf::Vector2f pos, sf::Vector2f dir, float spd, float dmg, const sf::Texture* tex);
         void update(float deltaTime);
         bool isExpired() const { return lifetime >= maxLifetime; }
     };
@@ -109,10 +127,13 @@ private:
 
     // Visual components
     sf::Sprite sprite;
-    std::vector<sf::Texture> idleTextures;
-    std::vector<sf::Texture> vanishTextures;
-    std::vector<sf::Texture> shriekTextures;
-    sf::Texture bulletTexture;
+    sf::Vector2f previousPosition;
+    // Shared frames from TextureCache, null when headless
+    const sf::Vector2i frameSize{ 64, 80 };
+    std::vector<const sf::Texture*> idleTextures;
+    std::vector<const sf::Texture*> vanishTextures;
+    std::vector<const sf::Texture*> shriekTextures;
+    const sf::Texture* bulletTexture = nullptr;
     std::vector<Projectile> projectiles;
     sf::RectangleShape collisionDebug;
 
@@ -124,7 +145,7 @@ private:
     float health;
     float speed = 100.f;
     float baseSpeed;
-    float avoidanceRadius = 80.f;
+    float avoidanceRadius = Steering::defaultAvoidanceRadius;
     float projectileSpeed = 400.f;
     float projectileDamage = 15.f;
     float attackRange = 250.f;
@@ -144,24 +165,16 @@ private:
     float repathTimer = 0.f;
     const float repathCooldown = 0.5f;
     Player* player = nullptr;
+    const RegionMap* regionMap = nullptr;
+    const DistanceField* wallField = nullptr;
+    const OccupancyPyramid* occupancy = nullptr; // line of sight
+    float wallAvoidance = Steering::defaultWallAvoidance; // tiles of clearance steering tries to keep
 
     // Collision
     sf::FloatRect collisionBox;
     float collisionShrinkFactor = 0.4f;
     float verticalCollisionOffset = 0.f;
 
-    // Pathfinding node
-    struct PathNode {
-        sf::Vector2i pos;
-        float cost;
-        float heuristic;
-        sf::Vector2i parent;
-
-        bool operator>(const PathNode& other) const {
-            return (cost + heuristic) > (other.cost + other.heuristic);
-        }
-    };
-
     // Helper methods
 
     void loadIdleTextures();
@@ -172,8 +185,8 @@ private:
     void updateVanishAnimation(float deltaTime);
     void updateShriekAnimation(float deltaTime);
     void updateCollisionBox();
-    void updatePathfinding(const std::vector<std::vector<int>>& maze, float tileSize);
-    sf::Vector2f calculateSteeringForce(const std::vector<std::vector<int>>& maze,
+    void updatePathfinding(const TileMap& maze, float tileSize);
+    sf::Vector2f calculateSteeringForce(const TileMap& maze,
         float tileSize, const std::vector<Enemy*>& otherEnemies);
     void attackPlayer();
     void setHPBarVisible(bool visible);
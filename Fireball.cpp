@@ -2,8 +2,8 @@
 #include <cmath>
 #include <iostream>
 
-Fireball::Fireball(sf::Vector2f position, sf::Vector2f direction, float speed, float damage)
-    : speed(speed), damage(damage), alive(true) {
+Fireball::Fireball(sf::Vector2f position, sf::Vector2f direction, float speed, float damage, const Rng& effectRng)
+    : speed(speed), damage(damage), alive(true), flickerRng(effectRng) {
 
     // Calculate size and damage scaling factors
     const float damageScale = 0.8f + (damage / 80.0f) * 0.7f; // Scales between 0.8-1.5 based on damage (20-80)
@@ -113,17 +113,17 @@ void Fireball::update(float deltaTime, std::vector<Enemy*>& enemies) {
     checkCollisionWithEnemies(enemies);
 }
 
-void Fireball::draw(sf::RenderWindow& window) {
+void Fireball::draw(RenderSnapshot& frame) {
     if (!alive) return;
 
     // Draw flames from outer to inner for proper blending
     for (auto it = flames.rbegin(); it != flames.rend(); ++it) {
-        window.draw(*it);
+        frame.draw(*it);
     }
 
 
     if (showDebug) {
-        window.draw(collisionDebug);
+        frame.draw(collisionDebug);
     }
 }
 
@@ -161,15 +161,15 @@ void Fireball::updateFireEffect(float deltaTime)
 
         for (size_t i = 0; i < flames.size(); ++i) {
             // Random slight position offsets
-            float offsetX = (rand() % 5 - 2) * 0.5f;
-            float offsetY = (rand() % 5 - 2) * 0.5f;
+            float offsetX = flickerRng.range(-2, 2) * 0.5f;
+            float offsetY = flickerRng.range(-2, 2) * 0.5f;
             sf::Vector2f pos = flames[0].getPosition();
             flames[i].setPosition(pos.x + offsetX, pos.y + offsetY);
 
             // Color variation
             sf::Color c = flames[i].getFillColor();
-            int r = std::min(255, std::max(0, c.r + (rand() % 11 - 5)));
-            int g = std::min(255, std::max(0, c.g + (rand() % 11 - 5)));
+            int r = std::min(255, std::max(0, c.r + flickerRng.range(-5, 5)));
+            int g = std::min(255, std::max(0, c.g + flickerRng.range(-5, 5)));
             flames[i].setFillColor(sf::Color(r, g, c.b, c.a));
         }
     }
@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include "Enemy.h"
+#include "Rng.h"
+#include "RenderSnapshot.h"
 
 class Fireball {
 private:
@@ -34,15 +36,16 @@ private:
     float damage;
     float baseDamage;
     float currentScale = 1.f;
+    Rng flickerRng;
 
 public:
-    Fireball(sf::Vector2f position, sf::Vector2f direction, float speed, float damage );
+    Fireball(sf::Vector2f position, sf::Vector2f direction, float speed, float damage, const Rng& effectRng);
 
     ~Fireball();
     void updateCollisionBox();
  
     void update(float deltaTime, std::vector<Enemy*>& enemies);
-    void draw(sf::RenderWindow& window);
+    void draw(RenderSnapshot& frame);
     bool isAlive() const;
     void toggleDebug(bool debug);
     sf::FloatRect getCollisionBox() const;
@@ -0,0 +1,52 @@
+#include "FlightRecorder.h"
+#include "Log.h"
+#include "Profiler.h"
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+bool FlightRecorder::frameFinished(std::uint64_t seed, int level) {
+    if (!isArmed()) return false;
+    if (framesSinceDump < cooldownFrames) framesSinceDump++;
+
+    float frameMs = Profiler::lastFrameTime();
+    if (frameMs <= budgetMs || framesSinceDump < cooldownFrames) return false;
+    framesSinceDump = 0;
+    hitches++;
+
+    // Newest frames first until the window is covered
+    std::vector<float> times = Profiler::frameTimes();
+    int frameCount = 0;
+    float covered = 0.f;
+    for (auto it = times.rbegin(); it != times.rend() && covered < seconds * 1000.f; ++it) {
+        covered += *it;
+        frameCount++;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    std::ostringstream name;
+    name << directory << "/hitch_" << seed << "_L" << level << "_" << hitches << ".json";
+    std::string path = name.str();
+
+    std::vector<std::pair<std::string, std::string>> info = {
+        { "seed", std::to_string(seed) },
+        { "level", std::to_string(level) },
+        { "frame_ms", std::to_string(frameMs) },
+        { "budget_ms", std::to_string(budgetMs) }
+    };
+    bool written = Profiler::writeChromeTrace(path, frameCount, info);
+    if (written) {
+        LOG_WARN(Log::Profiling, "Frame took " << frameMs << " ms, saved the last " << covered / 1000.f
+            << " s to " << path);
+    }
+    else {
+        LOG_ERROR(Log::Profiling, "Cannot write hitch trace " << path);
+    }
+
+    // Writing takes a while itself; keep it out of the next frame's time
+    Profiler::discardFrame();
+    return written;
+}
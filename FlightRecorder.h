@@ -0,0 +1,35 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Keeps the profiler recording all the time and, when a frame runs over
+// budget, saves the last few seconds of it as a Chrome trace named after
+// the seed and level. A hitch seen once can then be looked at without
+// having had the profiler open.
+class FlightRecorder {
+public:
+    // Frames kept while armed: the window at up to 240 frames per second
+    static const int historyFrames = 1200;
+
+    // Milliseconds a frame may take; 0 turns dumping off
+    void setBudget(float ms) { budgetMs = ms; }
+    float getBudget() const { return budgetMs; }
+    bool isArmed() const { return budgetMs > 0.f; }
+    // Seconds before the slow frame that go into the dump
+    void setWindow(float newSeconds) { seconds = newSeconds; }
+    void setDirectory(const std::string& path) { directory = path; }
+
+    // Checks the frame Profiler::endFrame() just closed and dumps the window
+    // when it was too slow; true when a trace was written
+    bool frameFinished(std::uint64_t seed, int level);
+    int hitchCount() const { return hitches; }
+
+private:
+    float budgetMs = 25.f;
+    float seconds = 5.f;
+    std::string directory = "hitches";
+    // A stall tends to drag a few slow frames behind it; one dump covers them
+    static const int cooldownFrames = 300;
+    int framesSinceDump = cooldownFrames;
+    int hitches = 0;
+};
@@ -1,65 +1,254 @@
 #include "Game.h"
+#include "KeyboardInput.h"
+#include "LevelFile.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "NullBackend.h"
+#include "ReplayInput.h"
+#include "ScriptedInput.h"
+#include "TextureCache.h"
+#include "WindowBackend.h"
 #include <algorithm>
 #include <cmath>
 #include <sstream>
 
 // Initialize static constants
-const float Game::tileSize = 32.f;
+const float Game::tileSize = LevelGenerator::tileSize;
 
-Game::Game() : window(sf::VideoMode(1280, 720), "Maze Adventure") {
-    window.setFramerateLimit(60);
+Game::Game(std::uint64_t seed, const std::string& levelPack, bool headless) : backend(createBackend(headless)), seed(seed), levelPack(levelPack) {
+    Profiler::setThreadName("main");
+    tracing = Profiler::isEnabled();
+    updateProfiling();
     gameOver=false;
     showMenu=true;
     totalEnemiesKilled=0;
     loadHighScores();
     // Initialize views
-    gameView.setSize(window.getSize().x, window.getSize().y);
-    uiView = window.getDefaultView();
+    sf::Vector2u size = backend->getSize();
+    gameView.setSize(size.x, size.y);
+    uiView = sf::View(sf::FloatRect(0.f, 0.f, size.x, size.y));
+    // Without a window nobody is at the keys: stand still until told otherwise
+    if (sf::RenderWindow* window = backend->getWindow()) {
+        input = std::make_unique<KeyboardInput>(*window, gameView);
+    }
+    else {
+        input = std::make_unique<ScriptedInput>();
+    }
     //load sound 
     loadSounds();
+    audioRng = Rng(seed).split(Rng::Audio);
+    player.setRandomStream(Rng(seed).split(Rng::Effects));
    
 
 
     // Initialize game
     loadHighScores();
-    generateMaze();
+    prefetcher.setLevelPack(levelPack);
+    // Every way into play starts with resetGame, which loads the level;
+    // build level 1 in the background until then
+    prefetcher.request(currentLevel, seed);
     player.setEnemyList(&enemies);
 }
 
 Game::~Game()
 {
+    // Nothing may be drawn once members start going away
+    backend->holdWindow();
     menuSound.stop();
     gameOverSound.stop();
 }
 
+//picks the backend; headless also keeps every texture unloaded
+std::unique_ptr<RenderBackend> Game::createBackend(bool headless) {
+    TextureCache::setGraphicsEnabled(!headless);
+    if (headless) {
+        return std::make_unique<NullBackend>(1280, 720);
+    }
+    return std::make_unique<WindowBackend>(1280, 720, "Maze Adventure");
+}
+
 //main run code
 void Game::run() {
     sf::Clock clock;
+    float accumulator = 0.f;
+    Profiler::discardFrame();
 
-    while (window.isOpen()) {
-        float deltaTime = clock.restart().asSeconds();
+    while (backend->isOpen()) {
+        float frameTime = std::min(clock.restart().asSeconds(), maxFrameTime);
 
+        // Drivers other than a person start over instead of waiting in menus
+        if ((showMenu || gameOver) && !input->isLive()) {
+            resetGame();
+        }
+
+        // Menus draw on this thread
         if (showMenu) {
+            backend->holdWindow();
             showMainMenu();
+            Profiler::discardFrame();
             continue;
         }
 
         if (gameOver) {
+            backend->holdWindow();
             showGameOverScreen();
+            Profiler::discardFrame();
             continue;
         }
 
         processEvents();
+        if (!backend->isOpen()) break;
 
         // Only update if game has started
         if (gameStarted && !showMenu && !gameOver) {
-            update(deltaTime);
+            accumulator += frameTime;
+            int steps = 0;
+            while (accumulator >= simStep && steps < maxStepsPerFrame && !gameOver) {
+                step();
+                accumulator -= simStep;
+                steps++;
+            }
+            // Still behind after the step budget: drop the backlog instead of
+            // spiralling into ever longer frames
+            if (steps == maxStepsPerFrame) accumulator = std::min(accumulator, simStep);
+        }
+        else {
+            accumulator = 0.f;
         }
 
-        render();
+        render(accumulator / simStep);
+        sampleMetrics();
+        Profiler::endFrame();
+        hitches.frameFinished(seed, currentLevel);
     }
 }
 
+//one fixed simulation step, remembering where everything started from
+void Game::step() {
+    PROFILE_SCOPE("Game::step");
+    player.savePreviousPosition();
+    for (auto& enemy : enemies) {
+        enemy->savePreviousPosition();
+    }
+    update(simStep);
+
+    stepCount++;
+    if (recording) recording->steps = stepCount;
+    if (stepCount % Replay::checkpointInterval == 0) checkpoint();
+}
+
+void Game::setSimulationRate(float hz) {
+    if (hz > 0.f && std::isfinite(hz)) simStep = 1.f / hz;
+}
+
+void Game::setHitchBudget(float ms) {
+    hitches.setBudget(ms);
+    updateProfiling();
+}
+
+void Game::setInputSource(std::unique_ptr<InputSource> source) {
+    if (source) input = std::move(source);
+}
+
+void Game::record(Replay& replay) {
+    replay.seed = seed;
+    replay.step = simStep;
+    replay.steps = 0;
+    replay.inputs.clear();
+    replay.checkpoints.clear();
+    input = std::make_unique<RecordingInput>(std::move(input), replay);
+    recording = &replay;
+}
+
+void Game::playBack(const Replay& replay) {
+    if (replay.seed != seed) {
+        LOG_WARN(Log::Replay, "Replay was recorded with seed " << replay.seed << ", not " << seed);
+    }
+    // The exact step length, not a rate converted back and forth
+    simStep = replay.step;
+    input = std::make_unique<ReplayInput>(replay);
+    playback = &replay;
+}
+
+//FNV-1a over everything that moves, bit for bit
+std::uint64_t Game::stateHash() const {
+    std::uint64_t hash = 0xCBF29CE484222325ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+        }
+    };
+    auto mixFloat = [&mix](float value) { mix(&value, sizeof(value)); };
+    auto mixInt = [&mix](std::int32_t value) { mix(&value, sizeof(value)); };
+
+    mixInt(currentLevel);
+    mixInt(totalEnemiesKilled);
+    mixFloat(player.getPosition().x);
+    mixFloat(player.getPosition().y);
+    mixFloat(player.getHealth());
+    mixFloat(player.getStamina());
+    mixInt(static_cast<std::int32_t>(enemies.size()));
+    for (const auto& enemy : enemies) {
+        mixFloat(enemy->getPosition().x);
+        mixFloat(enemy->getPosition().y);
+        mixFloat(enemy->getHealth());
+    }
+    mixInt(static_cast<std::int32_t>(collectables.size()));
+    return hash;
+}
+
+//records or verifies the state hash for this step
+void Game::checkpoint() {
+    std::uint64_t hash = stateHash();
+    if (recording) {
+        recording->checkpoints.push_back({ stepCount, hash });
+    }
+    if (!playback) return;
+
+    const auto& expected = playback->checkpoints;
+    while (nextCheckpoint < expected.size() && expected[nextCheckpoint].step < stepCount) {
+        nextCheckpoint++;
+    }
+    if (nextCheckpoint == expected.size() || expected[nextCheckpoint].step != stepCount) return;
+
+    if (expected[nextCheckpoint].hash == hash) {
+        matchedCheckpoints++;
+    }
+    else if (divergedStep < 0) {
+        divergedStep = stepCount;
+        LOG_WARN(Log::Replay, "Replay diverged at step " << stepCount);
+    }
+}
+
+//steps the game with nothing drawn and nobody at the keys; a death starts over
+void Game::runHeadless(int ticks, bool drawFrames) {
+    resetGame();
+    int runs = 1;
+    int deepestLevel = currentLevel;
+
+    sf::Clock clock;
+    Profiler::discardFrame();
+    for (int tick = 0; tick < ticks; tick++) {
+        step();
+        if (drawFrames) render();
+        sampleMetrics();
+        Profiler::endFrame();
+        hitches.frameFinished(seed, currentLevel);
+        deepestLevel = std::max(deepestLevel, currentLevel);
+        if (gameOver) {
+            resetGame();
+            runs++;
+        }
+    }
+    float seconds = clock.getElapsedTime().asSeconds();
+
+    std::cout << ticks << " ticks in " << seconds << " s ("
+        << (seconds > 0.f ? ticks / seconds : 0.f) << " ticks/s), "
+        << runs << " run(s), deepest level " << deepestLevel
+        << ", " << totalEnemiesKilled << " kills in the last run" << std::endl;
+}
+
 // for collision
 void Game::toggleCollisionDebug()
 {
@@ -82,123 +271,14 @@ void Game::addEnemy(sf::Vector2f position, float health, Enemy::EnemyType type)
 {
     enemies.push_back(std::make_unique<Enemy>(position, health, type));
     enemies.back()->setPlayer(&player);
-}
-
-// Spawn collectables in the maze
-void Game::spawnCollectables() {
-    if (powerupSpawned) return; // Prevent spawning if already spawned
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> typeDis(0, 4);
-    std::uniform_int_distribution<> posDis(1, static_cast<int>(maze.size()) - 2);
-    std::uniform_real_distribution<> valueDis(10.f, 30.f);
-
-    collectables.clear();
-
-    // Calculate base powerup count based on level and enemies
-    int baseCount = 3 + (currentLevel / 3); // Minimum 3, +1 every 3 levels
-    int enemyBasedCount = static_cast<int>(enemies.size()) / 3;
-    int toSpawn = std::min(baseCount + enemyBasedCount, 8); // Cap at 8 powerups
-
-    // Get player position in grid coordinates
-    sf::Vector2i playerGrid(
-        static_cast<int>(player.getPosition().x / tileSize),
-        static_cast<int>(player.getPosition().y / tileSize)
-    );
-
-    for (int i = 0; i < toSpawn; i++) {
-        int attempts = 0;
-        bool validPosition = false;
-
-        while (!validPosition && attempts < 50) { // Increased max attempts
-            int x = posDis(gen);
-            int y = posDis(gen);
-            attempts++;
-
-            // Check basic validity
-            if (maze[y][x] != 0) continue;
-
-            // Convert to grid position for distance check
-            sf::Vector2i powerupGrid(x, y);
-
-            // Calculate distance to player
-            float distanceToPlayer = std::sqrt(
-                std::pow(x - playerGrid.x, 2) +
-                std::pow(y - playerGrid.y, 2)
-            );
-
-            // Minimum distance from player (3 tiles)
-            if (distanceToPlayer < 3.0f) continue;
-
-            // Check distance from other powerups
-            bool tooCloseToOther = false;
-            for (const auto& collectable : collectables) {
-                sf::Vector2f pos = collectable.getPosition();
-                sf::Vector2i otherGrid(
-                    static_cast<int>(pos.x / tileSize),
-                    static_cast<int>(pos.y / tileSize)
-                );
-
-                float distance = std::sqrt(
-                    std::pow(x - otherGrid.x, 2) +
-                    std::pow(y - otherGrid.y, 2)
-                );
-
-                if (distance < 2.0f) { // Minimum 2 tiles apart
-                    tooCloseToOther = true;
-                    break;
-                }
-            }
-
-            if (tooCloseToOther) continue;
-
-            // Adjust spawn weights based on level
-            Collectable::Type type;
-            float value;
-
-            // Higher levels get more powerful powerups
-            if (currentLevel > 5) {
-                // 50% chance for combat powerups in later levels
-                int weightedRoll = gen() % (currentLevel > 10 ? 10 : 15);
-                if (weightedRoll < 5) {
-                    type = static_cast<Collectable::Type>(2 + gen() % 3); // DAMAGE, SPEED, or FIRE_RATE
-                }
-                else {
-                    type = static_cast<Collectable::Type>(gen() % 2); // HEALTH or MANA
-                }
-
-                // Scale values with level
-                value = valueDis(gen) * (1.0f + currentLevel * 0.05f);
-            }
-            else {
-                type = static_cast<Collectable::Type>(typeDis(gen));
-                value = valueDis(gen);
-            }
-
-            // Double health values
-            if (type == Collectable::Type::HEALTH) {
-                value *= 2.0f;
-            }
-
-            collectables.emplace_back(
-                sf::Vector2f(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2),
-                type,
-                value
-            );
-            validPosition = true;
-        }
-
-        if (!validPosition && showCollisionDebug) {
-            std::cout << "Failed to find valid position for powerup after " << attempts << " attempts\n";
-        }
-    }
-
-    powerupSpawned = true;
+    enemies.back()->setRegionMap(&regions);
+    enemies.back()->setWallField(&walls);
+    enemies.back()->setOccupancy(&occupancy);
 }
 
 // Update collectables
 void Game::updateCollectables(float deltaTime) {
+    PROFILE_SCOPE("Game::updateCollectables");
     for (auto& collectable : collectables) {
         collectable.update(deltaTime);
     }
@@ -211,6 +291,7 @@ void Game::updateCollectables(float deltaTime) {
 
 // Check for collisions between player and collectables
 void Game::checkCollectableCollisions() {
+    PROFILE_SCOPE("Game::checkCollectableCollisions");
     for (auto it = collectables.begin(); it != collectables.end(); ) {
         if (player.getBounds().intersects(it->getBounds())) {
             it->applyEffect(player);
@@ -222,30 +303,6 @@ void Game::checkCollectableCollisions() {
     }
 }
 
-//spawns enemies with different variables
-Game::EnemySpawnWeights Game::getLevelSpawnWeights(int level) const {
-    EnemySpawnWeights weights;
-
-    // Use explicit float versions of min/max
-    weights.basic = std::max<float>(10.0f, 60.0f - level * 3.0f);
-    weights.fast = 20.0f + std::min<float>(20.0f, level * 2.0f) - std::max<float>(0.0f, (level - 5.0f) * 1.5f);
-    weights.tank = 5.0f + level * 1.5f;
-    weights.ranged = std::min<float>(30.0f, std::max<float>(0.0f, level - 3) * 4.0f);
-
-    return weights;
-}
-
-float Game::getHealthMultiplier(int level) const {
-    return 1.0f + (level * 0.1f); // +10% health per level
-}
-
-float Game::getDamageMultiplier(int level) const {
-    return 1.0f + (level * 0.07f); // +7% damage per level
-}
-
-float Game::getSpeedMultiplier(int level) const {
-    return 1.0f + (level * 0.03f); // +3% speed per level
-}
 //shows starting screen
 void Game::showMainMenu() {
     // Play menu sound (only if not already playing)
@@ -255,9 +312,10 @@ void Game::showMainMenu() {
         }
     }
     catch (const std::exception& e) {
-        std::cerr << "Error playing menu sound: " << e.what() << std::endl;
+        LOG_ERROR(Log::Assets, "Error playing menu sound: " << e.what());
     }
 
+    sf::RenderWindow& window = *backend->getWindow();
     MainMenu menu(window);
     MainMenu::MenuResult result = menu.Show(window);
 
@@ -277,119 +335,6 @@ void Game::showMainMenu() {
         break;
     }
 }
-//creates a rectangle room
-void Game::createRectRoom(int x, int y, int width, int height)
-{
-    for (int ry = y; ry < y + height && ry < maze.size() - 1; ry++) {
-        for (int rx = x; rx < x + width && rx < maze[ry].size() - 1; rx++) {
-            maze[ry][rx] = 0;
-        }
-    }
-}
-// creates a circular room
-void Game::createCircularRoom(int x, int y, int width, int height)
-{
-    float radiusX = width / 2.0f;
-    float radiusY = height / 2.0f;
-    float centerX = x + radiusX;
-    float centerY = y + radiusY;
-
-    for (int ry = y; ry < y + height && ry < maze.size() - 1; ry++) {
-        for (int rx = x; rx < x + width && rx < maze[ry].size() - 1; rx++) {
-            float dx = (rx - centerX) / radiusX;
-            float dy = (ry - centerY) / radiusY;
-            if (dx * dx + dy * dy <= 1.0f) {
-                maze[ry][rx] = 0;
-            }
-        }
-    }
-}
-// creates a winding path
-void Game::createWindingPath(std::mt19937& gen)
-{
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-    std::uniform_int_distribution<> dirDis(0, 3);
-    std::uniform_int_distribution<> lenDis(5, 15);
-    std::uniform_int_distribution<> turnDis(0, 4); // 20% chance to turn
-
-    int x = posDis(gen);
-    int y = posDis(gen);
-    int length = lenDis(gen);
-    int direction = dirDis(gen); // 0=right, 1=left, 2=down, 3=up
-
-    for (int i = 0; i < length; i++) {
-        // Carve current position
-        if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
-            maze[y][x] = 0;
-            // Carve wider path
-            for (int w = 0; w < corridorWidth; w++) {
-                if (direction == 0 && x + w < maze[0].size() - 1) maze[y][x + w] = 0;
-                if (direction == 1 && x - w > 0) maze[y][x - w] = 0;
-                if (direction == 2 && y + w < maze.size() - 1) maze[y + w][x] = 0;
-                if (direction == 3 && y - w > 0) maze[y - w][x] = 0;
-            }
-        }
-
-        // Possibly change direction
-        if (turnDis(gen) == 0) {
-            direction = dirDis(gen);
-        }
-
-        // Move in current direction
-        switch (direction) {
-        case 0: x++; break;
-        case 1: x--; break;
-        case 2: y++; break;
-        case 3: y--; break;
-        }
-    }
-}
-// creates deadendss
-void Game::createDeadEnd(std::mt19937& gen)
-{
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-    std::uniform_int_distribution<> lenDis(3, 8);
-    std::uniform_int_distribution<> dirDis(0, 3);
-
-    // Find a wall adjacent to a path
-    int x, y;
-    bool found = false;
-    for (int tries = 0; tries < 50 && !found; tries++) {
-        x = posDis(gen);
-        y = posDis(gen);
-        if (maze[y][x] == 1) {
-            // Check adjacent tiles for path
-            for (int dy = -1; dy <= 1 && !found; dy++) {
-                for (int dx = -1; dx <= 1 && !found; dx++) {
-                    if (dx == 0 && dy == 0) continue;
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    if (nx > 0 && nx < maze[0].size() - 1 &&
-                        ny > 0 && ny < maze.size() - 1 &&
-                        maze[ny][nx] == 0) {
-                        found = true;
-                    }
-                }
-            }
-        }
-    }
-
-    if (found) {
-        int length = lenDis(gen);
-        int direction = dirDis(gen);
-        for (int i = 0; i < length; i++) {
-            if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
-                maze[y][x] = 0;
-                switch (direction) {
-                case 0: x++; break;
-                case 1: x--; break;
-                case 2: y++; break;
-                case 3: y--; break;
-                }
-            }
-        }
-    }
-}
 //exit and entry sounds
 void Game::loadSounds() {
     // Load your sound files
@@ -409,29 +354,29 @@ void Game::loadSounds() {
         }
         else {
             // Error handling
-            std::cerr << "Failed to load sound: " << file << std::endl;
+            LOG_ERROR(Log::Assets, "Failed to load sound: " << file);
         }
     }
 
     
         // First check if sound files exist
         if (!std::ifstream("assets/menu.wav").good()) {
-            std::cerr << "ERROR: menu.wav file missing!" << std::endl;
+            LOG_ERROR(Log::Assets, "menu.wav file missing!");
         }
         if (!std::ifstream("assets/over.wav").good()) {
-            std::cerr << "ERROR: over.wav file missing!" << std::endl;
+            LOG_ERROR(Log::Assets, "over.wav file missing!");
         }
 
         // Then try loading
         if (!menuBuffer.loadFromFile("assets/menu.wav")) {
-            std::cerr << "Failed to load menu sound!" << std::endl;
+            LOG_ERROR(Log::Assets, "Failed to load menu sound!");
             // Create empty buffer to prevent crashes
             menuBuffer = sf::SoundBuffer();
         }
         menuSound.setBuffer(menuBuffer);
 
         if (!gameOverBuffer.loadFromFile("assets/over.wav")) {
-            std::cerr << "Failed to load game over sound!" << std::endl;
+            LOG_ERROR(Log::Assets, "Failed to load game over sound!");
             gameOverBuffer = sf::SoundBuffer();
         }
         gameOverSound.setBuffer(gameOverBuffer);
@@ -443,128 +388,18 @@ void Game::loadSounds() {
 void Game::playRandomLevelSound() {
     if (soundBuffers.empty()) return;
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(0, soundBuffers.size() - 1);
-
-    int randomIndex = dis(gen);
+    int randomIndex = audioRng.range(0, static_cast<int>(soundBuffers.size()) - 1);
     levelSound.setBuffer(soundBuffers[randomIndex]);
     levelSound.play();
 }
 
-//ensures a valid maze path is there
-bool Game::validateMazePath() {
-    // Simple implementation that checks if exit is reachable from player position
-    sf::Vector2i playerTile(
-        static_cast<int>(player.getPosition().x / tileSize),
-        static_cast<int>(player.getPosition().y / tileSize)
-    );
-    sf::Vector2i exitTile(
-        static_cast<int>(exit.getPosition().x / tileSize),
-        static_cast<int>(exit.getPosition().y / tileSize)
-    );
-
-    // Simple flood fill algorithm
-    std::vector<std::vector<bool>> visited(maze.size(), std::vector<bool>(maze[0].size(), false));
-    std::queue<sf::Vector2i> queue;
-    queue.push(playerTile);
-    visited[playerTile.y][playerTile.x] = true;
-
-    while (!queue.empty()) {
-        sf::Vector2i current = queue.front();
-        queue.pop();
-
-        // Found exit
-        if (current == exitTile) {
-            return true;
-        }
-
-        // Check adjacent tiles
-        for (int dy = -1; dy <= 1; dy++) {
-            for (int dx = -1; dx <= 1; dx++) {
-                if (dx != 0 && dy != 0) continue; // Only cardinal directions
-
-                sf::Vector2i next(current.x + dx, current.y + dy);
-                if (next.x >= 0 && next.x < maze[0].size() &&
-                    next.y >= 0 && next.y < maze.size() &&
-                    maze[next.y][next.x] == 0 && !visited[next.y][next.x]) {
-                    visited[next.y][next.x] = true;
-                    queue.push(next);
-                }
-            }
-        }
-    }
-
-    return false;
-}
-
-//connects other rooms to main room
-void Game::connectMainRooms() {
-    // Find all rooms (contiguous 0s)
-    std::vector<std::vector<sf::Vector2i>> rooms;
-    std::vector<std::vector<bool>> visited(maze.size(), std::vector<bool>(maze[0].size(), false));
-
-    for (int y = 0; y < maze.size(); y++) {
-        for (int x = 0; x < maze[y].size(); x++) {
-            if (maze[y][x] == 0 && !visited[y][x]) {
-                // New room found, flood fill to identify it
-                std::vector<sf::Vector2i> room;
-                std::queue<sf::Vector2i> queue;
-                queue.push({ x, y });
-                visited[y][x] = true;
-
-                while (!queue.empty()) {
-                    sf::Vector2i current = queue.front();
-                    queue.pop();
-                    room.push_back(current);
-
-                    // Check adjacent tiles
-                    for (int dy = -1; dy <= 1; dy++) {
-                        for (int dx = -1; dx <= 1; dx++) {
-                            if (dx != 0 && dy != 0) continue; // Only cardinal directions
-
-                            sf::Vector2i next(current.x + dx, current.y + dy);
-                            if (next.x >= 0 && next.x < maze[0].size() &&
-                                next.y >= 0 && next.y < maze.size() &&
-                                maze[next.y][next.x] == 0 && !visited[next.y][next.x]) {
-                                visited[next.y][next.x] = true;
-                                queue.push(next);
-                            }
-                        }
-                    }
-                }
-                rooms.push_back(room);
-            }
-        }
-    }
-
-    // Connect rooms with shortest paths
-    for (size_t i = 1; i < rooms.size(); i++) {
-        // Find closest points between room i and room i-1
-        float minDist = FLT_MAX;
-        sf::Vector2i from, to;
-
-        for (const auto& pt1 : rooms[i - 1]) {
-            for (const auto& pt2 : rooms[i]) {
-                float dist = (pt1.x - pt2.x) * (pt1.x - pt2.x) + (pt1.y - pt2.y) * (pt1.y - pt2.y);
-                if (dist < minDist) {
-                    minDist = dist;
-                    from = pt1;
-                    to = pt2;
-                }
-            }
-        }
-
-        // Connect these points
-        connectPoints(from, to);
-    }
-}
-
 //allows for debug and camera scroll
 void Game::processEvents() {
     sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed) window.close();
+    while (backend->pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            backend->close();
+        }
 
         // Handle zoom with manual clamping
         if (event.type == sf::Event::MouseWheelScrolled) {
@@ -573,7 +408,21 @@ void Game::processEvents() {
             if (newZoom < minZoom) newZoom = minZoom;
             if (newZoom > maxZoom) newZoom = maxZoom;
             cameraZoom = newZoom;
-            gameView.setSize(window.getSize().x * cameraZoom, window.getSize().y * cameraZoom);
+            gameView.setSize(backend->getSize().x * cameraZoom, backend->getSize().y * cameraZoom);
+        }
+
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F3) {
+            showProfiler = !showProfiler;
+            updateProfiling();
+            // The HUD font is otherwise only loaded by the game over screen
+            if (showProfiler && font.getInfo().family.empty()) {
+                font.loadFromFile("assets/arial.ttf");
+            }
+        }
+        if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F4) {
+            if (Profiler::writeChromeTrace(traceFile)) {
+                LOG_INFO(Log::Profiling, "Saved profile to " << traceFile);
+            }
         }
 
         if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F1) {
@@ -600,11 +449,11 @@ void Game::processEvents() {
 
 // updates the game stuffs
 void Game::update(float deltaTime) {
-    window.setView(gameView);
-
+    PROFILE_SCOPE("Game::update");
     // Check for player death first
     if (player.getHealth() <= 0 && !gameOver) {
-        std::cout << "Player died! Triggering game over..." << std::endl;
+        LOG_INFO(Log::Game, "Player died! Triggering game over...");
+        Profiler::mark("game over", currentLevel);
         gameOver = true;
         return;  // Skip rest of update if game over
     }
@@ -624,100 +473,20 @@ void Game::update(float deltaTime) {
     sf::Vector2f previousPosition = player.getPosition();
 
     // Update player
-    player.update(deltaTime, window);
+    player.update(deltaTime, readPlayerInput(deltaTime));
 
     if (!player.isAlive() && !gameOver) {
+        Profiler::mark("game over", currentLevel);
         gameOver = true;
         return;
     }
-    // Wall collision detection
-    sf::Vector2i playerTile(
-        static_cast<int>(player.getPosition().x / tileSize),
-        static_cast<int>(player.getPosition().y / tileSize)
-    );
-
-
-    
-    bool collided = false;
-    for (int y = std::max(0, playerTile.y - 1); y <= std::min(static_cast<int>(maze.size()) - 1, playerTile.y + 1); y++) {
-        for (int x = std::max(0, playerTile.x - 1); x <= std::min(static_cast<int>(maze[0].size()) - 1, playerTile.x + 1); x++) {
-            if (maze[y][x] == 1) {
-                sf::FloatRect wallRect(x * tileSize, y * tileSize, tileSize, tileSize);
-                sf::FloatRect playerBounds = player.getBounds();
-
-                if (playerBounds.intersects(wallRect)) {
-                    // Calculate center points
-                    sf::Vector2f playerCenter(
-                        playerBounds.left + playerBounds.width / 2,
-                        playerBounds.top + playerBounds.height / 2
-                    );
-                    sf::Vector2f wallCenter(
-                        wallRect.left + wallRect.width / 2,
-                        wallRect.top + wallRect.height / 2
-                    );
-
-                    // Calculate minimum translation vector
-                    float pushX = (playerCenter.x < wallCenter.x) ?
-                        wallRect.left - (playerBounds.left + playerBounds.width) :
-                        (wallRect.left + wallRect.width) - playerBounds.left;
-
-                    float pushY = (playerCenter.y < wallCenter.y) ?
-                        wallRect.top - (playerBounds.top + playerBounds.height) :
-                        (wallRect.top + wallRect.height) - playerBounds.top;
-
-                    // Only push along the axis of least penetration
-                    if (std::abs(pushX) < std::abs(pushY)) {
-                        player.setPosition(player.getPosition().x + pushX, player.getPosition().y);
-                    }
-                    else {
-                        player.setPosition(player.getPosition().x, player.getPosition().y + pushY);
-                    }
-
-                    collided = true;
-                    break;
-                }
-            }
-        }
-        if (collided) break;
-    }
-
-    // If collision occurred and we're still intersecting, revert position
-    if (collided) {
-        sf::FloatRect playerBounds = player.getBounds();
-        for (int y = std::max(0, playerTile.y - 1); y <= std::min(static_cast<int>(maze.size()) - 1, playerTile.y + 1); y++) {
-            for (int x = std::max(0, playerTile.x - 1); x <= std::min(static_cast<int>(maze[0].size()) - 1, playerTile.x + 1); x++) {
-                if (maze[y][x] == 1) {
-                    sf::FloatRect wallRect(x * tileSize, y * tileSize, tileSize, tileSize);
-                    if (playerBounds.intersects(wallRect)) {
-                        player.setPosition(previousPosition);
-                        break;
-                    }
-                }
-            }
-        }
-    }
+    resolvePlayerCollision(previousPosition);
 
     // Update enemies
-    for (auto it = enemies.begin(); it != enemies.end(); ) {
-        if (!(*it)->isAlive()) {
-            it = enemies.erase(it);
-            enemiesKilledThisLevel++;
-            totalEnemiesKilled++;
-        }
-        else {
-            (*it)->update(deltaTime, maze, tileSize, getEnemyPointers());
-            if (showCollisionDebug) {
-                (*it)->toggleDebug(showCollisionDebug);
-            }
-            ++it;
-        }
-    }
+    updateEnemies(deltaTime);
     //collectables 
     updateCollectables(deltaTime);
     checkCollectableCollisions();
-    // Update camera
-    gameView.setCenter(player.getPosition());
-
     // Check level completion
     checkLevelCompletion();
 
@@ -734,386 +503,233 @@ void Game::update(float deltaTime) {
         highScoreText.setString("High Score: 0");
     }
 }
-// renders the walls floor player etc window too
-void Game::render() {
-    window.clear(sf::Color::Black);
 
-    // Draw game world
-    window.setView(gameView);
-    drawMaze();
-    window.draw(exit);
-    player.draw(window);
-    drawEnemies();
-    for (const auto& collectable : collectables) {
-        collectable.draw(window);
-    }
-    // Draw UI
-    window.setView(uiView);
-    drawUI();
+//pushes the player out of walls, or back to where it was if that fails
+void Game::resolvePlayerCollision(sf::Vector2f previousPosition) {
+    PROFILE_SCOPE("Game::resolvePlayerCollision");
+    // Resolve against the merged wall boxes only when the bounds touch a wall at all
+    bool collided = false;
+    if (touchesWall(player.getBounds())) {
+        nearbyWalls.clear();
+        wallMesh.query(tilesUnder(player.getBounds()), nearbyWalls);
+        for (const WallMesh::Rect& wall : nearbyWalls) {
+            sf::FloatRect wallRect(wall.x * tileSize, wall.y * tileSize, wall.width * tileSize, wall.height * tileSize);
+            sf::FloatRect playerBounds = player.getBounds();
+
+            if (playerBounds.intersects(wallRect)) {
+                // Calculate center points
+                sf::Vector2f playerCenter(
+                    playerBounds.left + playerBounds.width / 2,
+                    playerBounds.top + playerBounds.height / 2
+                );
+                sf::Vector2f wallCenter(
+                    wallRect.left + wallRect.width / 2,
+                    wallRect.top + wallRect.height / 2
+                );
 
-    window.display();
-}
+                // Calculate minimum translation vector
+                float pushX = (playerCenter.x < wallCenter.x) ?
+                    wallRect.left - (playerBounds.left + playerBounds.width) :
+                    (wallRect.left + wallRect.width) - playerBounds.left;
 
-//generates a suitable maze 
-void Game::generateMaze() {
-    int size = baseSize + (currentLevel - 1) * sizeIncreasePerLevel;
-    maze.assign(size, std::vector<int>(size, 1)); // Start with all walls
+                float pushY = (playerCenter.y < wallCenter.y) ?
+                    wallRect.top - (playerBounds.top + playerBounds.height) :
+                    (wallRect.top + wallRect.height) - playerBounds.top;
 
-    // Generate until we get a valid maze
-    bool valid = false;
-    int attempts = 0;
+                // Only push along the axis of least penetration
+                if (std::abs(pushX) < std::abs(pushY)) {
+                    player.setPosition(player.getPosition().x + pushX, player.getPosition().y);
+                }
+                else {
+                    player.setPosition(player.getPosition().x, player.getPosition().y + pushY);
+                }
 
-    while (!valid && attempts < 5) {
-        // Clear previous attempt (keep outer walls)
-        for (int y = 1; y < size - 1; y++) {
-            for (int x = 1; x < size - 1; x++) {
-                maze[y][x] = 1;
+                collided = true;
+                break;
             }
         }
-
-        // Enhanced generation with new parameters
-        generateRooms();
-        connectMainRooms();
-        createOpenAreas();
-        addMazeFeatures(); 
-
-        valid = validateMazePath();
-        attempts++;
     }
 
-    placePlayer();
-    placeExit();
-    spawnEnemies();
-}
-
-//generates rooms 
-void Game::generateRooms() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> roomSizeDis(minRoomSize, maxRoomSize);
-    std::uniform_int_distribution<> posDis(2, static_cast<int>(maze.size()) - 3);
-    std::uniform_int_distribution<> roomVarDis(0, 10);
-
-    int roomCount = 12 + (currentLevel * 3); // More rooms
-
-    for (int i = 0; i < roomCount; i++) {
-        int roomWidth = roomSizeDis(gen);
-        int roomHeight = roomSizeDis(gen);
-        int x = posDis(gen);
-        int y = posDis(gen);
-
-        // Ensure room stays within bounds
-        x = std::max(2, std::min(x, static_cast<int>(maze[0].size()) - roomWidth - 2));
-        y = std::max(2, std::min(y, static_cast<int>(maze.size()) - roomHeight - 2));
-
-        // More varied room shapes
-        if (roomVarDis(gen) > 7) { // 30% chance for non-rectangular rooms
-            createCircularRoom(x, y, roomWidth, roomHeight);
-        }
-        else {
-            createRectRoom(x, y, roomWidth, roomHeight);
-        }
+    // If collision occurred and we're still intersecting, revert position
+    if (collided && touchesWall(player.getBounds())) {
+        player.setPosition(previousPosition);
     }
 }
 
-//connects therooms for the player to move through
-void Game::connectRooms() {
-    std::vector<sf::Vector2i> roomCenters;
-
-    // Find room centers (simplified version)
-    for (int y = 1; y < maze.size() - 1; y++) {
-        for (int x = 1; x < maze[y].size() - 1; x++) {
-            if (maze[y][x] == 0) {
-                roomCenters.emplace_back(x, y);
-            }
-        }
-    }
-
-    // Connect rooms
-    if (!roomCenters.empty()) {
-        for (size_t i = 1; i < roomCenters.size(); i++) {
-            connectPoints(roomCenters[i - 1], roomCenters[i]);
-        }
-    }
+//asks the input source what the player does this step
+PlayerInput Game::readPlayerInput(float deltaTime) {
+    InputContext context{ deltaTime, player, enemies, maze, regions, occupancy,
+        exit.getPosition() + exit.getSize() / 2.f, tileSize };
+    return input->read(context);
 }
-
-//adds features to the maze
-void Game::connectPoints(sf::Vector2i p1, sf::Vector2i p2) {
-    // Horizontal connection
-    int stepX = p1.x < p2.x ? 1 : -1;
-    for (int x = p1.x; x != p2.x; x += stepX) {
-        for (int dy = -corridorWidth / 2; dy <= corridorWidth / 2; dy++) {
-            int y = p1.y + dy;
-            if (y > 0 && y < maze.size() - 1 && x > 0 && x < maze[y].size() - 1) {
-                maze[y][x] = 0;
-            }
-        }
-    }
-
-    // Vertical connection
-    int stepY = p1.y < p2.y ? 1 : -1;
-    for (int y = p1.y; y != p2.y; y += stepY) {
-        for (int dx = -corridorWidth / 2; dx <= corridorWidth / 2; dx++) {
-            int x = p2.x + dx;
-            if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
-                maze[y][x] = 0;
-            }
-        }
-    }
+// records the frame and hands it to the backend
+void Game::render(float alpha) {
+    PROFILE_SCOPE("Game::render");
+    RenderSnapshot& frame = backend->frame();
+    drawScene(frame, alpha);
+    Metrics::add(Metrics::DrawCalls, static_cast<std::int64_t>(frame.drawCallCount()));
+    Metrics::add(Metrics::Vertices, static_cast<std::int64_t>(frame.vertexCount()));
+    backend->present();
 }
 
-//ensures open areas are created
-void Game::createOpenAreas() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> areaSizeDis(5, 15);
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-
-    int areaCount = 3 + (currentLevel / 2);
-    for (int i = 0; i < areaCount; i++) {
-        int size = areaSizeDis(gen);
-        int x = posDis(gen);
-        int y = posDis(gen);
-
-        for (int dy = -size; dy <= size; dy++) {
-            for (int dx = -size; dx <= size; dx++) {
-                if (dx * dx + dy * dy <= size * size) {
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
-                        maze[ny][nx] = 0;
-                    }
-                }
-            }
-        }
-    }
-}
+// records the walls floor player etc and the UI on top
+void Game::drawScene(RenderSnapshot& frame, float alpha) {
+    frame.clear(sf::Color::Black);
 
-//special areas are created but not used in game , fur further update i am including this
-void Game::placeSpecialAreas() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> countDis(3, 5);
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-
-    int specialCount = countDis(gen);
-    for (int i = 0; i < specialCount; i++) {
-        int x = posDis(gen);
-        int y = posDis(gen);
-
-        // Find open space
-        while (y < maze.size() && x < maze[y].size() && maze[y][x] == 1) {
-            x = posDis(gen);
-            y = posDis(gen);
-        }
+    // Camera follows the interpolated player so it moves smoothly too
+    gameView.setCenter(player.getRenderPosition(alpha));
 
-        // Create 5x5 area
-        for (int dy = -2; dy <= 2; dy++) {
-            for (int dx = -2; dx <= 2; dx++) {
-                int nx = x + dx;
-                int ny = y + dy;
-                if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
-                    maze[ny][nx] = 0;
-                    if (dx == 0 && dy == 0) {
-                        maze[ny][nx] = 2; // Mark center as special
-                    }
-                }
-            }
-        }
+    // Draw game world
+    frame.setView(gameView);
+    drawMaze(frame);
+    player.draw(frame, alpha);
+    drawEnemies(frame, alpha);
+    for (const auto& collectable : collectables) {
+        collectable.draw(frame);
+    }
+    // Draw UI
+    frame.setView(uiView);
+    drawUI(frame);
+    if (showProfiler) {
+        drawProfiler(frame);
+        drawMetrics(frame);
     }
 }
 
-//places the player in the maze
-void Game::placePlayer() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dis(1, maze.size() - 2);
-
-    while (true) {
-        int x = dis(gen);
-        int y = dis(gen);
-
-        if (maze[y][x] == 0) {
-            player.setPosition(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2);
-            break;
-        }
+//generates the current level, waiting for the background one when it is on its way
+void Game::loadLevel() {
+    PROFILE_SCOPE("Game::loadLevel");
+    Profiler::mark("level", currentLevel);
+    std::unique_ptr<Level> level = prefetcher.wait(currentLevel, seed);
+    if (!level) {
+        // Never asked for: load or build it here
+        level = LevelFile::loadOrGenerate(generator, levelPack, currentLevel, seed);
     }
+    activateLevel(*level);
+
+    // Start on the following level while this one is played
+    prefetcher.request(currentLevel + 1, seed);
 }
 
-//places the exit in the maze
-void Game::placeExit() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    // Ensure exit is placed at least 1 tile away from outer walls
-    std::uniform_int_distribution<> dis(2, static_cast<int>(maze.size()) - 3);
-
-    while (true) {
-        int x = dis(gen);
-        int y = dis(gen);
-
-        if (maze[y][x] == 0) {
-            sf::Vector2f playerPos = player.getPosition();
-            sf::Vector2f exitPos(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2);
-
-            // Ensure exit is far enough from player
-            if (isFarEnough(
-                sf::Vector2i(playerPos.x / tileSize, playerPos.y / tileSize),
-                sf::Vector2i(x, y),
-                maze.size() * 0.4f)) {
-
-                exit.setSize(sf::Vector2f(tileSize, tileSize));
-                exit.setPosition(x * tileSize, y * tileSize);
-                exit.setFillColor(sf::Color::Green);
-                break;
-            }
-        }
+//moves a generated level into the running game
+void Game::activateLevel(Level& level) {
+    maze = std::move(level.maze);
+    regions = std::move(level.regions);
+    walls = std::move(level.walls);
+    occupancy = std::move(level.occupancy);
+    wallMesh = std::move(level.wallMesh);
+    // Keep the derived caches in step with later tile edits
+    maze.addListener(&regions);
+    maze.addListener(&walls);
+    maze.addListener(&occupancy);
+    maze.addListener(&wallMesh);
+    player.setPosition(level.playerStart);
+    player.savePreviousPosition(); // no blending across the level change
+
+    exit.setSize(sf::Vector2f(tileSize, tileSize));
+    exit.setPosition(level.exitPosition);
+    exit.setFillColor(sf::Color::Green);
+
+    spawnEnemies(level.enemySpawns);
+    Profiler::mark("enemies spawned", static_cast<std::int64_t>(enemies.size()));
+    collectables.clear();
+    for (const auto& spawn : level.collectables) {
+        collectables.emplace_back(spawn.position, spawn.type, spawn.value);
     }
 }
 
-//spawns enemies randomly
-void Game::spawnEnemies() {
+//creates the enemies picked by the generator
+void Game::spawnEnemies(const std::vector<Level::EnemySpawn>& spawns) {
     enemies.clear();
     enemiesKilledThisLevel = 0;
-    int enemyCount = baseEnemies + (currentLevel - 1) * enemiesIncreasePerLevel;
-
-    auto weights = getLevelSpawnWeights(currentLevel);
-    float totalWeight = weights.basic + weights.fast + weights.tank + weights.ranged;
-
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> typeDis(0.0f, totalWeight);
-    std::uniform_real_distribution<float> healthDis(80.0f, 120.0f);
-    std::uniform_int_distribution<> posDis(1, static_cast<int>(maze.size()) - 2);
-
-    for (int i = 0; i < enemyCount; i++) {
-        while (true) {
-            int x = posDis(gen);
-            int y = posDis(gen);
-
-            if (maze[y][x] == 0) {
-                sf::Vector2f pos(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2);
-
-                // Determine enemy type
-                float typeRoll = typeDis(gen);
-                Enemy::EnemyType type;
-
-                if (typeRoll < weights.basic) {
-                    type = Enemy::BASIC;
-                }
-                else if (typeRoll < weights.basic + weights.fast) {
-                    type = Enemy::FAST;
-                }
-                else if (typeRoll < weights.basic + weights.fast + weights.tank) {
-                    type = Enemy::TANK;
-                }
-                else {
-                    type = Enemy::RANGED;
-                }
 
-                // Apply level scaling
-                float health = healthDis(gen) * getHealthMultiplier(currentLevel);
-                auto enemy = std::make_unique<Enemy>(pos, health, type);
-                enemy->setPlayer(&player);
-
-                // Scale stats
-                enemy->setProjectileDamage(15.0f * getDamageMultiplier(currentLevel));
-                enemy->setMovementSpeed(100.0f * getSpeedMultiplier(currentLevel)); // Changed to setMovementSpeed
-
-                // Type-specific base adjustments
-                switch (type) {
-                case Enemy::FAST:
-                    enemy->setProjectileSpeed(500.0f);
-                    enemy->setAttackCooldown(0.3f);
-                    enemy->setMovementSpeed(150.0f * getSpeedMultiplier(currentLevel)); // Faster base speed
-                    break;
-                case Enemy::TANK:
-                    enemy->setProjectileDamage(25.0f * getDamageMultiplier(currentLevel));
-                    enemy->setAttackCooldown(1.0f);
-                    enemy->setMovementSpeed(70.0f * getSpeedMultiplier(currentLevel)); // Slower base speed
-                    break;
-                case Enemy::RANGED:
-                    enemy->setProjectileSpeed(450.0f);
-                    enemy->setAttackRange(350.0f);
-                    break;
-                }
-
-                enemies.push_back(std::move(enemy));
-                break;
-            }
+    for (const auto& spawn : spawns) {
+        auto enemy = std::make_unique<Enemy>(spawn.position, spawn.health, spawn.type);
+        enemy->setPlayer(&player);
+        enemy->setRegionMap(&regions);
+        enemy->setWallField(&walls);
+        enemy->setOccupancy(&occupancy);
+
+        // Scale stats
+        enemy->setProjectileDamage(15.0f * LevelGenerator::getDamageMultiplier(currentLevel));
+        enemy->setMovementSpeed(100.0f * LevelGenerator::getSpeedMultiplier(currentLevel)); // Changed to setMovementSpeed
+
+        // Type-specific base adjustments
+        switch (spawn.type) {
+        case Enemy::FAST:
+            enemy->setProjectileSpeed(500.0f);
+            enemy->setAttackCooldown(0.3f);
+            enemy->setMovementSpeed(150.0f * LevelGenerator::getSpeedMultiplier(currentLevel)); // Faster base speed
+            break;
+        case Enemy::TANK:
+            enemy->setProjectileDamage(25.0f * LevelGenerator::getDamageMultiplier(currentLevel));
+            enemy->setAttackCooldown(1.0f);
+            enemy->setMovementSpeed(70.0f * LevelGenerator::getSpeedMultiplier(currentLevel)); // Slower base speed
+            break;
+        case Enemy::RANGED:
+            enemy->setProjectileSpeed(450.0f);
+            enemy->setAttackRange(350.0f);
+            break;
         }
+
+        enemies.push_back(std::move(enemy));
     }
 }
 
 //updates enemies position render state etc
 void Game::updateEnemies(float deltaTime) {
+    PROFILE_SCOPE("Game::updateEnemies");
+    // Every enemy steers around the others through these pointers, so the
+    // dead are only removed once all of them have been updated
     auto livingEnemies = getEnemyPointers();
 
-    for (auto it = enemies.begin(); it != enemies.end(); ) {
-        auto& enemy = *it;
+    for (auto& enemy : enemies) {
         enemy->update(deltaTime, maze, tileSize, livingEnemies);
 
-        // Wall collision
+        if (showCollisionDebug) {
+            enemy->toggleDebug(showCollisionDebug);
+        }
+
+        // Wall collision: push out along the field gradient by the overlap
         sf::FloatRect enemyBounds = enemy->getCollisionBox();
-        for (int y = 0; y < maze.size(); y++) {
-            for (int x = 0; x < maze[y].size(); x++) {
-                if (maze[y][x] == 1) {
-                    sf::FloatRect wallRect(x * tileSize, y * tileSize, tileSize, tileSize);
-                    if (enemyBounds.intersects(wallRect)) {
-                        sf::Vector2f enemyPos = enemy->getPosition();
-                        sf::Vector2f wallCenter(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2);
-                        sf::Vector2f dir = enemyPos - wallCenter;
-                        float length = std::sqrt(dir.x * dir.x + dir.y * dir.y);
-                        if (length > 0) {
-                            enemy->setPosition(wallCenter + (dir / length) * (tileSize * 0.6f));
-                        }
-                    }
-                }
-            }
+        sf::Vector2f center(enemyBounds.left + enemyBounds.width / 2, enemyBounds.top + enemyBounds.height / 2);
+        float radius = std::min(enemyBounds.width, enemyBounds.height) / 2;
+        float clearance = walls.sample(center / tileSize) * tileSize;
+        if (clearance < radius) {
+            enemy->setPosition(enemy->getPosition() + walls.gradient(center / tileSize) * (radius - clearance));
         }
         // Projectile-wall collision
         for (auto& proj : enemy->getProjectiles()) {
-            sf::Vector2i projTile(
-                static_cast<int>(proj.sprite.getPosition().x / tileSize),
-                static_cast<int>(proj.sprite.getPosition().y / tileSize)
-            );
-
-            for (int y = std::max(0, projTile.y - 1); y <= std::min(static_cast<int>(maze.size()) - 1, projTile.y + 1); y++) {
-                for (int x = std::max(0, projTile.x - 1); x <= std::min(static_cast<int>(maze[0].size()) - 1, projTile.x + 1); x++) {
-                    if (maze[y][x] == 1) {
-                        sf::FloatRect wallRect(x * tileSize, y * tileSize, tileSize, tileSize);
-                        if (proj.collisionBox.intersects(wallRect)) {
-                            // Mark projectile for removal
-                            enemy->clearProjectiles();
-                            break;
-                        }
-                    }
-                }
+            if (touchesWall(proj.collisionBox)) {
+                // Clearing invalidates this loop, so stop here
+                enemy->clearProjectiles();
+                break;
             }
         }
-
-        if (!enemy->isAlive()) {
-            it = enemies.erase(it);
-            enemiesKilledThisLevel++;
-            totalEnemiesKilled++;
-        }
-        else {
-            ++it;
-        }
     }
+
+    auto dead = std::remove_if(enemies.begin(), enemies.end(),
+        [](const std::unique_ptr<Enemy>& enemy) { return !enemy->isAlive(); });
+    int killed = static_cast<int>(enemies.end() - dead);
+    enemies.erase(dead, enemies.end());
+    enemiesKilledThisLevel += killed;
+    totalEnemiesKilled += killed;
 }
 
 //draws the enemies
-void Game::drawEnemies() {
+void Game::drawEnemies(RenderSnapshot& frame, float alpha) {
+    PROFILE_SCOPE("Game::drawEnemies");
     for (auto& enemy : enemies) {
-        enemy->draw(window);
+        enemy->draw(frame, alpha);
         if (showCollisionDebug) {
-            enemy->drawDebug(window);
+            enemy->drawDebug(frame);
         }
     }
 }
 
-//draws the maze
-void Game::drawMaze() {
+//draws the maze: the visible floor as one quad, then one quad per merged wall box
+void Game::drawMaze(RenderSnapshot& frame) {
+    PROFILE_SCOPE("Game::drawMaze");
     // Get player position in tile coordinates
     sf::Vector2f playerPos = player.getPosition();
     int px = static_cast<int>(playerPos.x / tileSize);
@@ -1121,34 +737,29 @@ void Game::drawMaze() {
 
     // Calculate visible area with clamping
     int startX = std::max(0, px - renderDistance);
-    int endX = std::min(static_cast<int>(maze[0].size()) - 1, px + renderDistance);
+    int endX = std::min(maze.getWidth() - 1, px + renderDistance);
     int startY = std::max(0, py - renderDistance);
-    int endY = std::min(static_cast<int>(maze.size()) - 1, py + renderDistance);
-
-    // Pre-create tiles for better performance
-    sf::RectangleShape wallTile(sf::Vector2f(tileSize - 1, tileSize - 1));
-    wallTile.setFillColor(sf::Color(70, 70, 70));
-    wallTile.setOutlineThickness(0.f);
-
-    sf::RectangleShape floorTile(sf::Vector2f(tileSize - 1, tileSize - 1));
-    floorTile.setFillColor(sf::Color(30, 30, 30));
-    floorTile.setOutlineThickness(0.f);
+    int endY = std::min(maze.getHeight() - 1, py + renderDistance);
+
+    mazeVertices.clear();
+    auto addQuad = [this](float left, float top, float width, float height, sf::Color color) {
+        mazeVertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+        mazeVertices.append(sf::Vertex(sf::Vector2f(left + width, top), color));
+        mazeVertices.append(sf::Vertex(sf::Vector2f(left + width, top + height), color));
+        mazeVertices.append(sf::Vertex(sf::Vector2f(left, top + height), color));
+    };
 
-    // Draw tiles in the visible area
-    for (int y = startY; y <= endY; y++) {
-        for (int x = startX; x <= endX; x++) {
-            sf::Vector2f position(x * tileSize, y * tileSize);
+    addQuad(startX * tileSize, startY * tileSize, (endX - startX + 1) * tileSize, (endY - startY + 1) * tileSize,
+        sf::Color(30, 30, 30));
 
-            if (maze[y][x] == 1) { // Wall
-                wallTile.setPosition(position);
-                window.draw(wallTile);
-            }
-            else { // Floor (0)
-                floorTile.setPosition(position);
-                window.draw(floorTile);
-            }
-        }
+    // Boxes reaching past the visible area are drawn whole, the view clips them
+    nearbyWalls.clear();
+    wallMesh.query({ startX, startY, endX, endY }, nearbyWalls);
+    for (const WallMesh::Rect& wall : nearbyWalls) {
+        addQuad(wall.x * tileSize, wall.y * tileSize, wall.width * tileSize - 1, wall.height * tileSize - 1,
+            sf::Color(70, 70, 70));
     }
+    frame.draw(mazeVertices);
 
     // Draw exit with appropriate color based on enemy status
     if (enemies.empty()) {
@@ -1157,18 +768,173 @@ void Game::drawMaze() {
     else {
         exit.setFillColor(sf::Color(100, 100, 100));
     }
-    window.draw(exit);
+    frame.draw(exit);
 }
 
 //draws the UI
-void Game::drawUI() {
-    window.draw(levelText);
-    window.draw(killsText);
-    window.draw(highScoreText);
+void Game::drawUI(RenderSnapshot& frame) {
+    PROFILE_SCOPE("Game::drawUI");
+    frame.draw(levelText);
+    frame.draw(killsText);
+    frame.draw(highScoreText);
+}
+
+//gauges for the metrics, once per frame
+void Game::sampleMetrics() {
+    std::size_t projectiles = player.projectileCount();
+    std::size_t soundBytes = player.soundBytes();
+    for (const auto& enemy : enemies) {
+        projectiles += enemy->getProjectiles().size();
+        soundBytes += enemy->soundBytes();
+    }
+    for (const auto& buffer : soundBuffers) {
+        soundBytes += buffer.getSampleCount() * sizeof(sf::Int16);
+    }
+    soundBytes += (gameOverBuffer.getSampleCount() + menuBuffer.getSampleCount()) * sizeof(sf::Int16);
+
+    Metrics::set(Metrics::Enemies, static_cast<std::int64_t>(enemies.size()));
+    Metrics::set(Metrics::Projectiles, static_cast<std::int64_t>(projectiles));
+    Metrics::set(Metrics::Particles, static_cast<std::int64_t>(player.particleCount()));
+    Metrics::set(Metrics::SoundBytes, static_cast<std::int64_t>(soundBytes));
+    Metrics::endFrame();
+}
+
+//last metrics sample, left of the profiler
+void Game::drawMetrics(RenderSnapshot& frame) {
+    // Sized from character counts, not glyph bounds: measuring loads glyphs
+    // into the shared font while the render thread may be drawing with it
+    const unsigned int characterSize = 11;
+    const float characterWidth = 6.5f;
+    const float lineHeight = 13.f;
+
+    std::ostringstream lines;
+    size_t longest = 0;
+    Metrics::Sample sample = Metrics::last();
+    for (int i = 0; i < Metrics::Count; i++) {
+        std::ostringstream line;
+        line << Metrics::name(static_cast<Metrics::Id>(i)) << "  " << sample[i];
+        longest = std::max(longest, line.str().size());
+        lines << line.str() << "\n";
+    }
+
+    sf::Text text(lines.str(), font, characterSize);
+    sf::Vector2f size(longest * characterWidth, Metrics::Count * lineHeight);
+    float left = backend->getSize().x - 500.f - size.x - 20.f;
+    sf::RectangleShape background(sf::Vector2f(size.x + 10.f, size.y + 12.f));
+    background.setPosition(left - 5.f, 5.f);
+    background.setFillColor(sf::Color(0, 0, 0, 190));
+    frame.draw(background);
+    text.setPosition(left, 10.f);
+    frame.draw(text);
+}
+
+//keeps the profiler recording while the overlay, a trace or the flight recorder needs it
+void Game::updateProfiling() {
+    if (hitches.isArmed()) Profiler::setHistorySize(FlightRecorder::historyFrames);
+    Profiler::setEnabled(showProfiler || tracing || hitches.isArmed());
+}
+
+//frame time bars, then the last frame as a flame graph with one lane per thread
+void Game::drawProfiler(RenderSnapshot& frame) {
+    const float width = 480.f;
+    const float left = backend->getSize().x - width - 10.f;
+    const float top = 10.f;
+    const float graphHeight = 80.f;
+    const float budgetMs = 1000.f / 60.f;
+    const float msScale = graphHeight / (2.f * budgetMs); // two 60 Hz frames fill the graph
+    const float rowHeight = 12.f;
+    const float labelHeight = 14.f;
+    const int barCount = 160;
+
+    Profiler::Frame last;
+    bool haveFrame = Profiler::lastFrame(last);
+    std::vector<std::string> lanes = Profiler::threadNames();
+    std::vector<int> laneDepth(lanes.size(), 0);
+    if (haveFrame) {
+        for (const auto& event : last.events) {
+            if (event.thread < laneDepth.size()) {
+                laneDepth[event.thread] = std::max(laneDepth[event.thread], static_cast<int>(event.depth) + 1);
+            }
+        }
+    }
+    float flameHeight = 0.f;
+    for (int depth : laneDepth) {
+        if (depth > 0) flameHeight += labelHeight + depth * rowHeight;
+    }
+
+    sf::RectangleShape background(sf::Vector2f(width + 10.f, graphHeight + 30.f + flameHeight));
+    background.setPosition(left - 5.f, top - 5.f);
+    background.setFillColor(sf::Color(0, 0, 0, 190));
+    frame.draw(background);
+
+    // Frame times, newest on the right
+    std::vector<float> times = Profiler::frameTimes();
+    size_t first = times.size() > barCount ? times.size() - barCount : 0;
+    float barWidth = width / barCount;
+    sf::RectangleShape bar;
+    for (size_t i = first; i < times.size(); i++) {
+        float height = std::min(times[i] * msScale, graphHeight);
+        bar.setSize(sf::Vector2f(std::max(barWidth - 1.f, 1.f), height));
+        bar.setPosition(left + (i - first) * barWidth, top + graphHeight - height);
+        bar.setFillColor(times[i] <= budgetMs ? sf::Color(90, 200, 90) : sf::Color(230, 90, 60));
+        frame.draw(bar);
+    }
+    sf::RectangleShape budget(sf::Vector2f(width, 1.f));
+    budget.setPosition(left, top + graphHeight - budgetMs * msScale);
+    budget.setFillColor(sf::Color(255, 255, 255, 120));
+    frame.draw(budget);
+
+    std::ostringstream caption;
+    caption.setf(std::ios::fixed);
+    caption.precision(2);
+    caption << "frame " << (times.empty() ? 0.f : times.back()) << " ms   F4: save " << traceFile;
+    sf::Text label(caption.str(), font, 11);
+    label.setPosition(left, top + graphHeight + 4.f);
+    frame.draw(label);
+    if (!haveFrame) return;
+
+    // Flame graph of the last frame; work that began in an earlier frame is
+    // clipped to its start
+    float scale = width / std::max<float>(static_cast<float>(last.end - last.start), 1.f);
+    float laneTop = top + graphHeight + 24.f;
+    sf::RectangleShape block;
+    for (size_t lane = 0; lane < lanes.size(); lane++) {
+        if (laneDepth[lane] == 0) continue;
+
+        label.setString(lanes[lane]);
+        label.setPosition(left, laneTop);
+        frame.draw(label);
+        laneTop += labelHeight;
+
+        for (const auto& event : last.events) {
+            if (event.thread != lane) continue;
+            float x0 = std::max(0.f, (event.start - last.start) * scale);
+            float x1 = std::min(width, (event.end - last.start) * scale);
+            float y = laneTop + event.depth * rowHeight;
+
+            std::uint32_t hash = 2166136261u;
+            for (const char* c = event.name; *c; c++) {
+                hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+            }
+            block.setSize(sf::Vector2f(std::max(x1 - x0, 1.f), rowHeight - 1.f));
+            block.setPosition(left + x0, y);
+            block.setFillColor(sf::Color(90 + hash % 130, 90 + (hash >> 8) % 130, 90 + (hash >> 16) % 130));
+            frame.draw(block);
+
+            if (x1 - x0 > 60.f) {
+                sf::Text name(event.name, font, 9);
+                name.setFillColor(sf::Color::Black);
+                name.setPosition(left + x0 + 2.f, y);
+                frame.draw(name);
+            }
+        }
+        laneTop += laneDepth[lane] * rowHeight;
+    }
 }
 
 //checks if the level is completed
 void Game::checkLevelCompletion() {
+    PROFILE_SCOPE("Game::checkLevelCompletion");
     // Only check for level completion if player is at exit AND all enemies are dead
     if (player.getBounds().intersects(exit.getGlobalBounds()) && enemies.empty()) {
         levelComplete = true;
@@ -1180,11 +946,9 @@ void Game::checkLevelCompletion() {
 //makes level progression
 void Game::nextLevel() {
     currentLevel++;
-    generateMaze();
+    loadLevel();
     levelComplete = false;
     playRandomLevelSound();
-	powerupSpawned = false;
-	spawnCollectables();
 }
 
 //loads highscore from file
@@ -1223,17 +987,18 @@ void Game::resetGame()
     totalEnemiesKilled = 0;
     enemiesKilledThisLevel = 0;
     player.reset();
-    generateMaze();
-    spawnCollectables();
+    input->restart();
+    loadLevel();
     gameOver = false;
     showMenu = false;
     gameStarted = true; 
-    powerupSpawned = false;
     playRandomLevelSound();
 }
 
 // could have used another class but :) forgot to 
 void Game::showGameOverScreen() {
+    sf::RenderWindow& window = *backend->getWindow();
+
     // Play game over sound
     gameOverSound.play();
 
@@ -1243,7 +1008,7 @@ void Game::showGameOverScreen() {
 
     // Load Arial font 
     if (!font.loadFromFile("assets/arial.ttf")) {
-        std::cerr << "Failed to load Arial font!" << std::endl;
+        LOG_ERROR(Log::Assets, "Failed to load Arial font!");
     }
 
     // Title text with medieval style wording
@@ -1314,6 +1079,14 @@ void Game::showGameOverScreen() {
     createButton("Retreat to Menu", buttonY + 80.f, sf::Color(200, 200, 100), Button::Menu);
     createButton("Abandon Quest", buttonY + 160.f, sf::Color(200, 100, 100), Button::Exit);
 
+    // The world behind the overlay no longer changes, record it once
+    RenderSnapshot frozenWorld;
+    frozenWorld.clear();
+    frozenWorld.setView(gameView);
+    drawMaze(frozenWorld);
+    player.draw(frozenWorld);
+    drawEnemies(frozenWorld);
+
     // Game Over Loop
     while (window.isOpen() && gameOver) {
         sf::Event event;
@@ -1380,14 +1153,8 @@ void Game::showGameOverScreen() {
             }
         }
 
-        // Draw
-        window.clear();
-
         // Draw the game view first (frozen in its current state)
-        window.setView(gameView);
-        drawMaze();
-        player.draw(window);
-        drawEnemies();
+        frozenWorld.replay(window);
 
         // Draw UI overlay
         window.setView(uiView);
@@ -1406,7 +1173,7 @@ void Game::showGameOverScreen() {
 }
 
 //draws the digits for the score
-void Game::drawDigit(float x, float y, int digit)
+void Game::drawDigit(RenderSnapshot& frame, float x, float y, int digit)
 {
     // Each digit is made of up to 7 segments (like a digital display)
     sf::RectangleShape segment(sf::Vector2f(15, 5));
@@ -1417,31 +1184,31 @@ void Game::drawDigit(float x, float y, int digit)
         // Top
         segment.setSize(sf::Vector2f(20, 5));
         segment.setPosition(x, y);
-        window.draw(segment);
+        frame.draw(segment);
         // Left top
         segment.setSize(sf::Vector2f(5, 20));
         segment.setPosition(x, y);
-        window.draw(segment);
+        frame.draw(segment);
         // Right top
         segment.setPosition(x + 15, y);
-        window.draw(segment);
+        frame.draw(segment);
         // Bottom
         segment.setSize(sf::Vector2f(20, 5));
         segment.setPosition(x, y + 25);
-        window.draw(segment);
+        frame.draw(segment);
         // Left bottom
         segment.setSize(sf::Vector2f(5, 20));
         segment.setPosition(x, y + 10);
-        window.draw(segment);
+        frame.draw(segment);
         // Right bottom
         segment.setPosition(x + 15, y + 10);
-        window.draw(segment);
+        frame.draw(segment);
         break;
     case 1:
         // Right top
         segment.setSize(sf::Vector2f(5, 25));
         segment.setPosition(x + 15, y);
-        window.draw(segment);
+        frame.draw(segment);
         break;
         // Implement cases 2-9 similarly...
     case 2:
@@ -1457,129 +1224,36 @@ void Game::drawDigit(float x, float y, int digit)
 }
 
 //draws the number on the screen
-void Game::drawNumber(float x, float y, int number) {
+void Game::drawNumber(RenderSnapshot& frame, float x, float y, int number) {
     std::string numStr = std::to_string(number);
     float currentX = x;
 
     for (char c : numStr) {
         int digit = c - '0';
-        drawDigit(currentX, y, digit);
+        drawDigit(frame, currentX, y, digit);
         currentX += 25; // Space between digits
     }
 }
 
 //checks if the position is valid
 bool Game::isValidPosition(sf::Vector2i pos) {
-    return pos.x > 0 && pos.x < maze.size() - 1 && pos.y > 0 && pos.y < maze.size() - 1;
-}
-
-//checks if the distance between two points is valid
-bool Game::isFarEnough(sf::Vector2i pos1, sf::Vector2i pos2, float minDistance) {
-    float dx = pos1.x - pos2.x;
-    float dy = pos1.y - pos2.y;
-    return std::sqrt(dx * dx + dy * dy) >= minDistance;
+    return pos.x > 0 && pos.x < maze.getWidth() - 1 && pos.y > 0 && pos.y < maze.getHeight() - 1;
 }
 
-//creates deadends in the maze
-void Game::addDeadEnds() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> countDis(5, 10 + currentLevel);
-    std::uniform_int_distribution<> lengthDis(3, 8);
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-
-    for (int i = 0; i < countDis(gen); i++) {
-        int x = posDis(gen);
-        int y = posDis(gen);
-        int direction = gen() % 4;
-        int length = lengthDis(gen);
-
-        // Find a wall adjacent to a path
-        bool foundStart = false;
-        for (int tries = 0; tries < 20 && !foundStart; tries++) {
-            x = posDis(gen);
-            y = posDis(gen);
-
-            if (maze[y][x] == 1) {
-                // Check if adjacent to a path
-                for (int dy = -1; dy <= 1; dy++) {
-                    for (int dx = -1; dx <= 1; dx++) {
-                        if (dx == 0 && dy == 0) continue;
-                        int nx = x + dx;
-                        int ny = y + dy;
-                        if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
-                            if (maze[ny][nx] == 0) {
-                                foundStart = true;
-                                break;
-                            }
-                        }
-                    }
-                    if (foundStart) break;
-                }
-            }
-        }
-
-        if (foundStart) {
-            for (int j = 0; j < length; j++) {
-                if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
-                    maze[y][x] = 0;
-                    switch (direction) {
-                    case 0: x++; break;
-                    case 1: x--; break;
-                    case 2: y++; break;
-                    case 3: y--; break;
-                    }
-                }
-            }
-        }
-    }
-}
-//creates winding paths in the maze
-void Game::addDiagonalPaths() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> countDis(3, 5 + currentLevel / 2);
-    std::uniform_int_distribution<> posDis(1, maze.size() - 2);
-
-    for (int i = 0; i < countDis(gen); i++) {
-        int x1 = posDis(gen);
-        int y1 = posDis(gen);
-        int x2 = posDis(gen);
-        int y2 = posDis(gen);
-
-        // Ensure both ends are in walkable areas
-        if (maze[y1][x1] == 0 && maze[y2][x2] == 0) {
-            int dx = (x2 > x1) ? 1 : -1;
-            int dy = (y2 > y1) ? 1 : -1;
-
-            while (x1 != x2 && y1 != y2) {
-                x1 += dx;
-                y1 += dy;
-                if (x1 > 0 && x1 < maze[0].size() - 1 && y1 > 0 && y1 < maze.size() - 1) {
-                    maze[y1][x1] = 0;
-                    // Add some width to the diagonal
-                    if (gen() % 2 == 0 && x1 + dx > 0 && x1 + dx < maze[0].size() - 1) maze[y1][x1 + dx] = 0;
-                    if (gen() % 2 == 0 && y1 + dy > 0 && y1 + dy < maze.size() - 1) maze[y1 + dy][x1] = 0;
-                }
-            }
-        }
-    }
+//checks whether a world rectangle overlaps any wall tile, one pyramid query
+bool Game::touchesWall(const sf::FloatRect& bounds) const {
+    TileMap::TileRect area = tilesUnder(bounds);
+    return occupancy.anyWall(area.x0, area.y0, area.x1, area.y1);
 }
-//adds features
-void Game::addMazeFeatures() {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> featDis(0, 3);
-
-    // Add winding paths
-    for (int i = 0; i < 5 + currentLevel; i++) {
-        createWindingPath(gen);
-    }
 
-    // Add some dead ends
-    for (int i = 0; i < 3 + currentLevel; i++) {
-        createDeadEnd(gen);
-    }
+//tiles a world rectangle overlaps, with the same strict overlap as FloatRect::intersects
+TileMap::TileRect Game::tilesUnder(const sf::FloatRect& bounds) const {
+    return {
+        static_cast<int>(std::floor(bounds.left / tileSize)),
+        static_cast<int>(std::floor(bounds.top / tileSize)),
+        static_cast<int>(std::ceil((bounds.left + bounds.width) / tileSize)) - 1,
+        static_cast<int>(std::ceil((bounds.top + bounds.height) / tileSize)) - 1
+    };
 }
 
 
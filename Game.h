@@ -7,45 +7,91 @@
 #include <random>
 #include <limits>
 #include <fstream>
+#include <cstdint>
 #include "Player.h"
 #include "Enemy.h"
 #include "MainMenu.h"
 #include "Collectable.h"
+#include "DistanceField.h"
+#include "OccupancyPyramid.h"
+#include "RegionMap.h"
+#include "TileMap.h"
+#include "Rng.h"
+#include "Level.h"
+#include "LevelGenerator.h"
+#include "LevelPrefetcher.h"
+#include "RenderBackend.h"
+#include "InputSource.h"
+#include "Replay.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "FlightRecorder.h"
 
 class Game {
 public:
     // Constructor/Destructor
-    Game();
+    // levelPack: directory of pre-generated levels, empty to always generate
+    // headless: no window, no textures and no device input
+    explicit Game(std::uint64_t seed, const std::string& levelPack = "", bool headless = false);
     ~Game();
 
     // Core game loop
     void run();
+    // Runs the given number of simulation steps as fast as possible and
+    // prints the step rate. The player stands still unless an input source
+    // was set. drawFrames records every step's frame into the null backend,
+    // so draw call metrics are measured too.
+    void runHeadless(int ticks, bool drawFrames = false);
 
     // Debug and enemy management
     void toggleCollisionDebug();
     std::vector<Enemy*> getEnemyPointers();
     void addEnemy(sf::Vector2f position, float health, Enemy::EnemyType type);
 
+    std::uint64_t getSeed() const { return seed; }
+    // Simulation steps per second; rendering runs independently
+    void setSimulationRate(float hz);
+    // Frames slower than this many milliseconds save a trace of the seconds
+    // before them to hitches/; 0 turns that off
+    void setHitchBudget(float ms);
+    // Replaces who drives the player; anything but the keyboard skips the
+    // menus and starts over after dying
+    void setInputSource(std::unique_ptr<InputSource> source);
+
+    // Appends every step's input and periodic state hashes to replay, which
+    // must outlive the game. Call after setInputSource.
+    void record(Replay& replay);
+    // Drives the player from replay and checks its state hashes. The game
+    // must have been created with the replay's seed.
+    void playBack(const Replay& replay);
+    int checkpointsMatched() const { return matchedCheckpoints; }
+    // Step of the first checkpoint that did not match, -1 while on track
+    std::int64_t divergedAt() const { return divergedStep; }
+
 private:
+    // ===== Render Backend =====
+    // Created before everything else: it decides whether textures load at all
+    std::unique_ptr<RenderBackend> backend;
+    static std::unique_ptr<RenderBackend> createBackend(bool headless);
+
+    // ===== Input =====
+    std::unique_ptr<InputSource> input;
+
+    // ===== Replay =====
+    Replay* recording = nullptr;
+    const Replay* playback = nullptr;
+    std::uint32_t stepCount = 0;
+    size_t nextCheckpoint = 0;
+    int matchedCheckpoints = 0;
+    std::int64_t divergedStep = -1;
+    std::uint64_t stateHash() const;
+    void checkpoint();
+
     // ===== Collectables System =====
     std::vector<Collectable> collectables;
-    bool powerupSpawned = false;
-    void spawnCollectables();
     void updateCollectables(float deltaTime);
     void checkCollectableCollisions();
 
-    // ===== Difficulty Scaling =====
-    struct EnemySpawnWeights {
-        float basic;
-        float fast;
-        float tank;
-        float ranged;
-    };
-    EnemySpawnWeights getLevelSpawnWeights(int level) const;
-    float getHealthMultiplier(int level) const;
-    float getDamageMultiplier(int level) const;
-    float getSpeedMultiplier(int level) const;
-
     // ===== Game State =====
     bool gameStarted = false;
     bool showMenu = true;
@@ -57,20 +103,31 @@ private:
     bool gameOver = false;
     int highScoreLevel = 0;
 
-    // ===== Maze Generation Constants =====
-    static const int baseSize = 60;
-    static const int sizeIncreasePerLevel = 12;
+    // ===== Random Streams =====
+    // Everything random derives from the seed, so a seed reproduces a run
+    std::uint64_t seed;
+    Rng audioRng;
+
+    // ===== Maze Constants =====
     static const float tileSize;
-    static const int minRoomSize = 8;
-    static const int maxRoomSize = 18;
-    static const int corridorWidth = 5;
     static const int renderDistance = 20;
-    static const int baseEnemies = 3;
-    static const int enemiesIncreasePerLevel = 2;
+
+    // ===== Level Generation =====
+    // The next level is built in the background while this one is played
+    LevelGenerator generator;
+    LevelPrefetcher prefetcher;
+    std::string levelPack;
+    void loadLevel();
+    void activateLevel(Level& level);
 
     // ===== Game Objects =====
     std::vector<std::unique_ptr<Enemy>> enemies;
-    std::vector<std::vector<int>> maze;
+    TileMap maze;
+    RegionMap regions;
+    DistanceField walls;
+    OccupancyPyramid occupancy;
+    WallMesh wallMesh;
+    std::vector<WallMesh::Rect> nearbyWalls; // scratch for collision and drawing
     Player player;
     sf::RectangleShape exit;
 
@@ -85,7 +142,6 @@ private:
     void playRandomLevelSound();
 
     // ===== Views and UI =====
-    sf::RenderWindow window;
     sf::View gameView;
     sf::View uiView;
     sf::Font font;
@@ -93,6 +149,31 @@ private:
     sf::Text killsText;
     sf::Text highScoreText;
 
+    // ===== Timing =====
+    // The world advances in fixed steps, whatever the frame rate. Frames
+    // render between the last two steps, so lowering the step rate or
+    // rendering at 144 Hz does not change what happens.
+    float simStep = 1.f / 60.f;
+    static constexpr float maxFrameTime = 0.25f; // longer stalls are dropped, not simulated
+    static const int maxStepsPerFrame = 8;
+    void step();
+
+    // ===== Profiler =====
+    // F3 toggles the overlay, F4 saves the kept frames as a Chrome trace.
+    // Recording stays on while anything needs it: the overlay, the flight
+    // recorder or a trace asked for before the game started.
+    bool showProfiler = false;
+    bool tracing = false;
+    const std::string traceFile = "trace.json";
+    FlightRecorder hitches;
+    void updateProfiling();
+    void drawProfiler(RenderSnapshot& frame);
+
+    // ===== Metrics =====
+    // Sets the gauges and closes the metrics frame; shown with the profiler
+    void sampleMetrics();
+    void drawMetrics(RenderSnapshot& frame);
+
     // ===== Camera System =====
     float cameraZoom = 0.5f;
     const float minZoom = 0.3f;
@@ -109,43 +190,29 @@ private:
     void showMainMenu();
     void showGameOverScreen();
 
-    // ===== Maze Generation =====
-    void createRectRoom(int x, int y, int width, int height);
-    void createCircularRoom(int x, int y, int width, int height);
-    void createWindingPath(std::mt19937& gen);
-    void createDeadEnd(std::mt19937& gen);
-    void connectPoints(sf::Vector2i p1, sf::Vector2i p2);
-    void addDeadEnds();
-    void addDiagonalPaths();
-    void addMazeFeatures();
-
     // ===== Core Game Methods =====
     void processEvents();
     void update(float deltaTime);
-    void render();
-    void generateMaze();
-    bool validateMazePath();
-    void connectMainRooms();
-    void generateRooms();
-    void connectRooms();
-    void createOpenAreas();
-    void placeSpecialAreas();
-    void placePlayer();
-    void placeExit();
-    void spawnEnemies();
+    void resolvePlayerCollision(sf::Vector2f previousPosition);
+    PlayerInput readPlayerInput(float deltaTime);
+    void render(float alpha = 1.f);
+    void spawnEnemies(const std::vector<Level::EnemySpawn>& spawns);
     void updateEnemies(float deltaTime);
-    void drawEnemies();
+    void drawEnemies(RenderSnapshot& frame, float alpha = 1.f);
     void checkLevelCompletion();
     void nextLevel();
     void resetGame();
 
     // ===== Rendering Methods =====
-    void drawMaze();
-    void drawUI();
-    void drawDigit(float x, float y, int digit);
-    void drawNumber(float x, float y, int number);
+    void drawScene(RenderSnapshot& frame, float alpha);
+    void drawMaze(RenderSnapshot& frame);
+    sf::VertexArray mazeVertices{ sf::Quads };
+    void drawUI(RenderSnapshot& frame);
+    void drawDigit(RenderSnapshot& frame, float x, float y, int digit);
+    void drawNumber(RenderSnapshot& frame, float x, float y, int number);
 
     // ===== Utility Methods =====
     bool isValidPosition(sf::Vector2i pos);
-    bool isFarEnough(sf::Vector2i pos1, sf::Vector2i pos2, float minDistance);
+    bool touchesWall(const sf::FloatRect& bounds) const;
+    TileMap::TileRect tilesUnder(const sf::FloatRect& bounds) const;
 };
\ No newline at end of file
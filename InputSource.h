@@ -0,0 +1,33 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "Player.h"
+#include "Enemy.h"
+#include "OccupancyPyramid.h"
+#include "RegionMap.h"
+#include "TileMap.h"
+
+// What a driver gets to look at before deciding a step's input
+struct InputContext {
+    float deltaTime;
+    const Player& player;
+    const std::vector<std::unique_ptr<Enemy>>& enemies;
+    const TileMap& maze;
+    const RegionMap& regions;
+    const OccupancyPyramid& occupancy;
+    sf::Vector2f exitCenter;
+    float tileSize;
+};
+
+// Produces the player's input once per simulation step. The game does not
+// care whether a person, a script or the bot is behind it.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    virtual PlayerInput read(const InputContext& context) = 0;
+    // Called when a new run starts
+    virtual void restart() {}
+    // A person at the keys; otherwise the game skips the menus
+    virtual bool isLive() const { return false; }
+};
@@ -0,0 +1,82 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+
+JobSystem::JobSystem(int workerCount) {
+    if (workerCount < 0) {
+        workerCount = std::max(0, static_cast<int>(std::thread::hardware_concurrency()) - 1);
+    }
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+JobSystem& JobSystem::shared() {
+    static JobSystem system;
+    return system;
+}
+
+void JobSystem::parallelFor(int count, const std::function<void(int)>& job) {
+    if (count <= 0) return;
+
+    auto batch = std::make_shared<Batch>();
+    batch->job = &job;
+    batch->count = count;
+
+    if (!workers.empty() && count > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            batches.push_back(batch);
+        }
+        wake.notify_all();
+    }
+
+    runBatch(*batch);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [&batch] { return batch->done.load() == batch->count; });
+}
+
+//takes indices from the oldest unfinished batch
+void JobSystem::workerLoop() {
+    Profiler::setThreadName("job worker");
+    while (true) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !batches.empty(); });
+            if (stopping) return;
+
+            batch = batches.front();
+            // Every index is handed out: nobody else needs to find this batch
+            if (batch->next.load() >= batch->count) {
+                batches.pop_front();
+                continue;
+            }
+        }
+        runBatch(*batch);
+    }
+}
+
+void JobSystem::runBatch(Batch& batch) {
+    PROFILE_SCOPE("JobSystem::runBatch");
+    for (int index = batch.next++; index < batch.count; index = batch.next++) {
+        (*batch.job)(index);
+        if (++batch.done == batch.count) {
+            // Lock so the wait in parallelFor cannot miss the notification
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+}
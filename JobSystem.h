@@ -0,0 +1,50 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads running index-range jobs. The calling thread
+// always works on its own batch too, so nested or concurrent parallelFor
+// calls from several threads cannot deadlock, and a pool with no workers
+// simply runs everything on the caller.
+class JobSystem {
+public:
+    // workerCount < 0 picks one worker per extra hardware thread
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Process-wide pool used by default
+    static JobSystem& shared();
+
+    int getWorkerCount() const { return static_cast<int>(workers.size()); }
+
+    // Calls job(i) for every i in [0, count) and returns when all are done.
+    // Order and thread of each call are unspecified.
+    void parallelFor(int count, const std::function<void(int)>& job);
+
+private:
+    struct Batch {
+        const std::function<void(int)>* job = nullptr;
+        int count = 0;
+        std::atomic<int> next{ 0 };
+        std::atomic<int> done{ 0 };
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::deque<std::shared_ptr<Batch>> batches;
+    bool stopping = false;
+
+    void workerLoop();
+    void runBatch(Batch& batch);
+};
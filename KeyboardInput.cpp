@@ -0,0 +1,15 @@
+#include "KeyboardInput.h"
+
+PlayerInput KeyboardInput::read(const InputContext&) {
+    PlayerInput input;
+    input.left = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
+    input.right = sf::Keyboard::isKeyPressed(sf::Keyboard::D);
+    input.up = sf::Keyboard::isKeyPressed(sf::Keyboard::W);
+    input.down = sf::Keyboard::isKeyPressed(sf::Keyboard::S);
+    input.sprint = sf::Keyboard::isKeyPressed(sf::Keyboard::LShift);
+    input.dash = sf::Keyboard::isKeyPressed(sf::Keyboard::Space);
+    input.attack = sf::Mouse::isButtonPressed(sf::Mouse::Left);
+    input.charge = sf::Mouse::isButtonPressed(sf::Mouse::Right);
+    input.aim = window.mapPixelToCoords(sf::Mouse::getPosition(window), view);
+    return input;
+}
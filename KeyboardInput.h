@@ -0,0 +1,17 @@
+#pragma once
+#include "InputSource.h"
+
+// WASD to move, left shift to sprint, space to dash, left mouse for bolts
+// and right mouse to charge a fireball, aimed at the cursor
+class KeyboardInput : public InputSource {
+public:
+    // view maps the cursor into the world; both must outlive this
+    KeyboardInput(const sf::RenderWindow& window, const sf::View& view) : window(window), view(view) {}
+
+    PlayerInput read(const InputContext& context) override;
+    bool isLive() const override { return true; }
+
+private:
+    const sf::RenderWindow& window;
+    const sf::View& view;
+};
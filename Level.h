@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Enemy.h"
+#include "Collectable.h"
+#include "DistanceField.h"
+#include "OccupancyPyramid.h"
+#include "RegionMap.h"
+#include "TileMap.h"
+#include "WallMesh.h"
+
+// Everything needed to start playing a level. Built off the main thread by
+// LevelGenerator and handed to Game as a whole when the player reaches it.
+// Only plain data, so generator tools never create SFML drawables.
+struct Level {
+    struct EnemySpawn {
+        sf::Vector2f position;
+        float health;
+        Enemy::EnemyType type;
+    };
+
+    struct CollectableSpawn {
+        sf::Vector2f position;
+        Collectable::Type type;
+        float value;
+    };
+
+    // Milliseconds spent in each generation stage. The first four run per
+    // chunk and are summed over all chunks (CPU time); chunks is the wall
+    // time of that parallel pass.
+    struct StageTimes {
+        float rooms = 0.f;
+        float connect = 0.f;
+        float openAreas = 0.f;
+        float features = 0.f;
+        float chunks = 0.f;
+        float stitch = 0.f;
+        float repair = 0.f;
+        float placement = 0.f;
+        float walls = 0.f;
+
+        float total() const { return chunks + stitch + repair + placement + walls; }
+    };
+
+    int number = 0;
+    std::uint64_t seed = 0;
+    int repairs = 0; // corridors carved to reconnect cut-off regions
+    // Heap bytes of the generator's full-size scratch (int grid, labels,
+    // path distances), all still alive while the fields below are built
+    std::size_t generatorBytes = 0;
+
+    TileMap maze;
+    RegionMap regions;
+    // Derived from maze, not stored in level files
+    DistanceField walls;
+    OccupancyPyramid occupancy;
+    WallMesh wallMesh;
+    sf::Vector2f playerStart;
+    sf::Vector2f exitPosition; // top-left corner of the exit tile
+    std::vector<EnemySpawn> enemySpawns;
+    std::vector<CollectableSpawn> collectables;
+    StageTimes timings;
+};
@@ -0,0 +1,212 @@
+#include "LevelFile.h"
+#include "LevelGenerator.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    const char magic[4] = { 'M', 'Z', 'L', 'V' };
+
+    bool bigEndianHost() {
+        const std::uint16_t probe = 1;
+        std::uint8_t low;
+        std::memcpy(&low, &probe, 1);
+        return low == 0;
+    }
+
+    // Values are stored little endian whatever the host order
+    template <typename T>
+    void put(std::vector<std::uint8_t>& out, T value) {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (bigEndianHost()) std::reverse(bytes, bytes + sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // A floor tile of the map, for the stored start and exit positions
+    bool onFloor(const TileMap& maze, sf::Vector2f position) {
+        if (!std::isfinite(position.x) || !std::isfinite(position.y)) return false;
+        float x = std::floor(position.x / LevelGenerator::tileSize);
+        float y = std::floor(position.y / LevelGenerator::tileSize);
+        if (x < 0.f || y < 0.f || x >= maze.getWidth() || y >= maze.getHeight()) return false;
+        return !maze.isWall(static_cast<int>(x), static_cast<int>(y));
+    }
+
+    // Bounds-checked reader over the mapped bytes
+    struct Reader {
+        const std::uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+        bool ok = true;
+
+        template <typename T>
+        T get() {
+            T value{};
+            if (offset + sizeof(T) > size) {
+                ok = false;
+                return value;
+            }
+            std::uint8_t bytes[sizeof(T)];
+            std::memcpy(bytes, data + offset, sizeof(T));
+            if (bigEndianHost()) std::reverse(bytes, bytes + sizeof(T));
+            std::memcpy(&value, bytes, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+    };
+}
+
+bool LevelFile::write(const std::string& path, const Level& level) {
+    std::vector<std::vector<std::uint8_t>> chunks = level.maze.packedChunks();
+
+    std::vector<std::uint8_t> out;
+    out.insert(out.end(), magic, magic + 4);
+    put<std::uint32_t>(out, version);
+    put<std::uint64_t>(out, level.seed);
+    put<std::int32_t>(out, level.number);
+    put<std::int32_t>(out, level.repairs);
+    put<std::int32_t>(out, level.maze.getWidth());
+    put<std::int32_t>(out, level.maze.getHeight());
+    put<std::int32_t>(out, TileMap::chunkSize);
+    put<float>(out, level.playerStart.x);
+    put<float>(out, level.playerStart.y);
+    put<float>(out, level.exitPosition.x);
+    put<float>(out, level.exitPosition.y);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(level.enemySpawns.size()));
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(level.collectables.size()));
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(chunks.size()));
+
+    for (const auto& spawn : level.enemySpawns) {
+        put<float>(out, spawn.position.x);
+        put<float>(out, spawn.position.y);
+        put<float>(out, spawn.health);
+        put<std::int32_t>(out, static_cast<std::int32_t>(spawn.type));
+    }
+    for (const auto& collectable : level.collectables) {
+        put<float>(out, collectable.position.x);
+        put<float>(out, collectable.position.y);
+        put<float>(out, collectable.value);
+        put<std::int32_t>(out, static_cast<std::int32_t>(collectable.type));
+    }
+
+    std::uint32_t offset = static_cast<std::uint32_t>(out.size() + chunks.size() * 8);
+    for (const auto& chunk : chunks) {
+        put<std::uint32_t>(out, offset);
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(chunk.size()));
+        offset += static_cast<std::uint32_t>(chunk.size());
+    }
+    for (const auto& chunk : chunks) {
+        out.insert(out.end(), chunk.begin(), chunk.end());
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+std::unique_ptr<Level> LevelFile::load(const std::string& path) {
+    PROFILE_SCOPE("LevelFile::load");
+    MappedFile mapping;
+    if (!mapping.open(path)) return nullptr;
+
+    Reader in{ mapping.data(), mapping.size() };
+    if (in.size < 4 || std::memcmp(in.data, magic, 4) != 0) return nullptr;
+    in.offset = 4;
+    if (in.get<std::uint32_t>() != version) return nullptr;
+
+    auto level = std::make_unique<Level>();
+    level->seed = in.get<std::uint64_t>();
+    level->number = in.get<std::int32_t>();
+    level->repairs = in.get<std::int32_t>();
+    int width = in.get<std::int32_t>();
+    int height = in.get<std::int32_t>();
+    int chunkSize = in.get<std::int32_t>();
+    level->playerStart.x = in.get<float>();
+    level->playerStart.y = in.get<float>();
+    level->exitPosition.x = in.get<float>();
+    level->exitPosition.y = in.get<float>();
+    std::uint32_t enemyCount = in.get<std::uint32_t>();
+    std::uint32_t collectableCount = in.get<std::uint32_t>();
+    std::uint32_t chunkCount = in.get<std::uint32_t>();
+    if (!in.ok || chunkSize != TileMap::chunkSize || width < 0 || height < 0) return nullptr;
+
+    size_t expectedChunks = static_cast<size_t>((width + chunkSize - 1) / chunkSize) *
+        ((height + chunkSize - 1) / chunkSize);
+    if (chunkCount != expectedChunks) return nullptr;
+    // Counts must fit in the file before anything is reserved for them
+    if ((static_cast<size_t>(enemyCount) + collectableCount) * 16 + chunkCount * 8 > in.size - in.offset) {
+        return nullptr;
+    }
+
+    level->enemySpawns.reserve(enemyCount);
+    for (std::uint32_t i = 0; i < enemyCount; i++) {
+        Level::EnemySpawn spawn;
+        spawn.position.x = in.get<float>();
+        spawn.position.y = in.get<float>();
+        spawn.health = in.get<float>();
+        std::int32_t type = in.get<std::int32_t>();
+        if (type < Enemy::BASIC || type > Enemy::RANGED) return nullptr;
+        spawn.type = static_cast<Enemy::EnemyType>(type);
+        level->enemySpawns.push_back(spawn);
+    }
+
+    level->collectables.reserve(collectableCount);
+    for (std::uint32_t i = 0; i < collectableCount; i++) {
+        sf::Vector2f position;
+        position.x = in.get<float>();
+        position.y = in.get<float>();
+        float value = in.get<float>();
+        std::int32_t type = in.get<std::int32_t>();
+        if (type < 0 || type > static_cast<std::int32_t>(Collectable::Type::FIRE_RATE)) return nullptr;
+        level->collectables.push_back({ position, static_cast<Collectable::Type>(type), value });
+    }
+
+    std::vector<TileMap::PackedChunk> chunks(chunkCount);
+    for (auto& chunk : chunks) {
+        std::uint32_t offset = in.get<std::uint32_t>();
+        std::uint32_t size = in.get<std::uint32_t>();
+        if (!in.ok || static_cast<size_t>(offset) + size > in.size) return nullptr;
+
+        chunk = { in.data + offset, size };
+        if (!TileMap::isValidChunk(chunk)) return nullptr;
+    }
+    if (!in.ok) return nullptr;
+
+    level->maze = TileMap::fromPacked(width, height, chunks);
+    // Positions the game would index the map with must be on it
+    if (!onFloor(level->maze, level->playerStart) || !onFloor(level->maze, level->exitPosition)) return nullptr;
+    Bitboard floor = level->maze.walkable();
+    level->regions.build(floor);
+    level->walls.build(floor);
+    level->occupancy.build(floor);
+    level->wallMesh.build(floor);
+    return level;
+}
+
+std::unique_ptr<Level> LevelFile::loadOrGenerate(LevelGenerator& generator, const std::string& directory,
+    int levelNumber, std::uint64_t seed) {
+    if (directory.empty()) return generator.generate(levelNumber, seed);
+
+    std::string path = packPath(directory, seed, levelNumber);
+    std::unique_ptr<Level> level = load(path);
+    if (!level || level->number != levelNumber || level->seed != seed) {
+        level = generator.generate(levelNumber, seed);
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+        if (!write(path, *level)) {
+            LOG_WARN(Log::General, "Could not write " << path << ", level " << levelNumber << " is not cached");
+        }
+    }
+    return level;
+}
+
+std::string LevelFile::packPath(const std::string& directory, std::uint64_t seed, int levelNumber) {
+    return directory + "/level_" + std::to_string(seed) + "_" + std::to_string(levelNumber) + ".lvl";
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Level.h"
+
+class LevelGenerator;
+
+// Versioned binary level format. Tiles are stored as TileMap's run-length
+// encoded chunks and decoded straight from the mapped file on load.
+//
+// Layout (little endian, no padding):
+//   header       "MZLV", version u32, seed u64, level i32, repairs i32,
+//                width i32, height i32, chunk size i32,
+//                player start 2xf32, exit position 2xf32,
+//                enemy count u32, collectable count u32, chunk count u32
+//   enemies      x f32, y f32, health f32, type i32
+//   collectables x f32, y f32, value f32, type i32
+//   chunk table  offset u32, size u32 per chunk (offsets from file start)
+//   chunk data   run-length bytes
+class LevelFile {
+public:
+    static const std::uint32_t version = 2;
+
+    static bool write(const std::string& path, const Level& level);
+    // nullptr when the file is missing, truncated, from another version, or
+    // its player start or exit is not a floor tile of the map
+    static std::unique_ptr<Level> load(const std::string& path);
+
+    // Loads a level from a pack directory, generating and storing it when
+    // missing (the directory is created if needed). An empty directory just
+    // generates.
+    static std::unique_ptr<Level> loadOrGenerate(LevelGenerator& generator, const std::string& directory,
+        int levelNumber, std::uint64_t seed);
+
+    // File name of a level inside a level pack directory
+    static std::string packPath(const std::string& directory, std::uint64_t seed, int levelNumber);
+};
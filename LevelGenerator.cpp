@@ -0,0 +1,731 @@
+#include "LevelGenerator.h"
+#include "Bitboard.h"
+#include "Profiler.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+LevelGenerator::LevelGenerator(JobSystem* jobs)
+    : jobs(jobs ? jobs : &JobSystem::shared()) {
+}
+
+//builds a complete level for the given number and seed
+std::unique_ptr<Level> LevelGenerator::generate(int levelNumber, std::uint64_t seed) {
+    PROFILE_SCOPE("LevelGenerator::generate");
+    currentLevel = levelNumber;
+    this->seed = seed;
+
+    generateMaze();
+
+    sf::Clock clock;
+    placePlayer();
+    placeExit();
+    spawnEnemies();
+    spawnCollectables();
+    timings.placement = clock.restart().asSeconds() * 1000.f;
+
+    auto level = std::make_unique<Level>();
+    level->number = levelNumber;
+    level->seed = seed;
+    level->repairs = repairs;
+    level->generatorBytes = maze.capacity() * sizeof(std::vector<int>) +
+        regions.memoryUsage() + placement.memoryUsage();
+    for (const auto& row : maze) {
+        level->generatorBytes += row.capacity() * sizeof(int);
+    }
+    level->maze = TileMap::fromGrid(maze);
+    level->regions = std::move(regions);
+    // Wall distances, occupancy and merged wall boxes for steering,
+    // collision, sight and drawing
+    clock.restart();
+    Bitboard floor = level->maze.walkable();
+    level->walls.build(floor, *jobs);
+    level->occupancy.build(floor);
+    level->wallMesh.build(floor, *jobs);
+    timings.walls = clock.restart().asSeconds() * 1000.f;
+    level->playerStart = playerPosition;
+    level->exitPosition = exitPosition;
+    level->enemySpawns = std::move(enemySpawns);
+    level->collectables = std::move(collectables);
+    level->timings = timings;
+
+    maze.clear();
+    maze.shrink_to_fit();
+    placement = PlacementField();
+    enemySpawns.clear();
+    collectables.clear();
+    return level;
+}
+
+//creates a rectangle room
+void LevelGenerator::createRectRoom(int x, int y, int width, int height)
+{
+    for (int ry = y; ry < y + height && ry < maze.size() - 1; ry++) {
+        for (int rx = x; rx < x + width && rx < maze[ry].size() - 1; rx++) {
+            maze[ry][rx] = 0;
+        }
+    }
+}
+
+// creates a circular room
+void LevelGenerator::createCircularRoom(int x, int y, int width, int height)
+{
+    float radiusX = width / 2.0f;
+    float radiusY = height / 2.0f;
+    float centerX = x + radiusX;
+    float centerY = y + radiusY;
+
+    for (int ry = y; ry < y + height && ry < maze.size() - 1; ry++) {
+        for (int rx = x; rx < x + width && rx < maze[ry].size() - 1; rx++) {
+            float dx = (rx - centerX) / radiusX;
+            float dy = (ry - centerY) / radiusY;
+            if (dx * dx + dy * dy <= 1.0f) {
+                maze[ry][rx] = 0;
+            }
+        }
+    }
+}
+
+// creates a winding path
+void LevelGenerator::createWindingPath(Rng& rng)
+{
+    int maxPos = static_cast<int>(maze.size()) - 2;
+
+    int x = rng.range(1, maxPos);
+    int y = rng.range(1, maxPos);
+    int length = rng.range(5, 15);
+    int direction = rng.range(0, 3); // 0=right, 1=left, 2=down, 3=up
+
+    for (int i = 0; i < length; i++) {
+        // Carve current position
+        if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
+            maze[y][x] = 0;
+            // Carve wider path
+            for (int w = 0; w < corridorWidth; w++) {
+                if (direction == 0 && x + w < maze[0].size() - 1) maze[y][x + w] = 0;
+                if (direction == 1 && x - w > 0) maze[y][x - w] = 0;
+                if (direction == 2 && y + w < maze.size() - 1) maze[y + w][x] = 0;
+                if (direction == 3 && y - w > 0) maze[y - w][x] = 0;
+            }
+        }
+
+        // Possibly change direction
+        if (rng.range(0, 4) == 0) {
+            direction = rng.range(0, 3);
+        }
+
+        // Move in current direction
+        switch (direction) {
+        case 0: x++; break;
+        case 1: x--; break;
+        case 2: y++; break;
+        case 3: y--; break;
+        }
+    }
+}
+
+// creates deadendss
+void LevelGenerator::createDeadEnd(Rng& rng)
+{
+    int maxPos = static_cast<int>(maze.size()) - 2;
+
+    // Find a wall adjacent to a path
+    int x, y;
+    bool found = false;
+    for (int tries = 0; tries < 50 && !found; tries++) {
+        x = rng.range(1, maxPos);
+        y = rng.range(1, maxPos);
+        if (maze[y][x] == 1) {
+            // Check adjacent tiles for path
+            for (int dy = -1; dy <= 1 && !found; dy++) {
+                for (int dx = -1; dx <= 1 && !found; dx++) {
+                    if (dx == 0 && dy == 0) continue;
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (nx > 0 && nx < maze[0].size() - 1 &&
+                        ny > 0 && ny < maze.size() - 1 &&
+                        maze[ny][nx] == 0) {
+                        found = true;
+                    }
+                }
+            }
+        }
+    }
+
+    if (found) {
+        int length = rng.range(3, 8);
+        int direction = rng.range(0, 3);
+        for (int i = 0; i < length; i++) {
+            if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
+                maze[y][x] = 0;
+                switch (direction) {
+                case 0: x++; break;
+                case 1: x--; break;
+                case 2: y++; break;
+                case 3: y--; break;
+                }
+            }
+        }
+    }
+}
+
+//connects other rooms to main room
+void LevelGenerator::connectMainRooms() {
+    PROFILE_SCOPE("LevelGenerator::connectMainRooms");
+    // Find all rooms (contiguous 0s)
+    regions.build(maze);
+
+    // Carve the minimum spanning tree of nearest tile pairs between rooms
+    for (const auto& link : connector.findLinks(maze, regions)) {
+        connectPoints(link.from, link.to);
+    }
+}
+
+//generates a suitable maze: square chunks in parallel, then stitched together
+void LevelGenerator::generateMaze() {
+    PROFILE_SCOPE("LevelGenerator::generateMaze");
+    int size = baseSize + (currentLevel - 1) * sizeIncreasePerLevel;
+    maze.assign(size, std::vector<int>(size, 1)); // Start with all walls
+    levelRng = Rng::forLevel(seed, currentLevel);
+    timings = Level::StageTimes();
+    repairs = 0;
+
+    // Every chunk has its own generator, grid and stream and writes only its
+    // own tiles, so the result does not depend on scheduling or thread count
+    int chunks = chunksPerSide(size);
+    int side = size / chunks;
+    float density = 1.f / (chunks * chunks);
+    Rng chunkStreams = levelRng.split(Rng::Chunks);
+    std::vector<Level::StageTimes> chunkTimes(chunks * chunks);
+    std::vector<int> chunkRepairs(chunks * chunks, 0);
+
+    sf::Clock clock;
+    jobs->parallelFor(chunks * chunks, [&](int index) {
+        LevelGenerator worker(jobs);
+        worker.buildChunk(currentLevel, chunkStreams.split(index), side, density);
+
+        int originX = (index % chunks) * side;
+        int originY = (index / chunks) * side;
+        for (int y = 0; y < side; y++) {
+            std::copy(worker.maze[y].begin(), worker.maze[y].end(), maze[originY + y].begin() + originX);
+        }
+        chunkTimes[index] = worker.timings;
+        chunkRepairs[index] = worker.repairs;
+    });
+    timings.chunks = clock.restart().asSeconds() * 1000.f;
+
+    for (int i = 0; i < chunks * chunks; i++) {
+        timings.rooms += chunkTimes[i].rooms;
+        timings.connect += chunkTimes[i].connect;
+        timings.openAreas += chunkTimes[i].openAreas;
+        timings.features += chunkTimes[i].features;
+        repairs += chunkRepairs[i];
+    }
+
+    clock.restart();
+    stitchChunks(chunks, side);
+    timings.stitch = clock.restart().asSeconds() * 1000.f;
+
+    // Seams are crossed once per neighbour pair, so this is normally just
+    // the final labelling; it still joins anything stitching missed
+    repairConnectivity();
+    timings.repair = clock.restart().asSeconds() * 1000.f;
+}
+
+//picks the most chunks per side that divide the map evenly and stay large enough
+int LevelGenerator::chunksPerSide(int size) {
+    for (int chunks = size / minChunkSize; chunks > 1; chunks--) {
+        if (size % chunks == 0) return chunks;
+    }
+    return 1;
+}
+
+//generates one chunk on its own grid; its outer ring stays wall so
+//neighbouring chunks are separated by a two tile seam until stitched
+void LevelGenerator::buildChunk(int levelNumber, const Rng& rng, int side, float density) {
+    PROFILE_SCOPE("LevelGenerator::buildChunk");
+    currentLevel = levelNumber;
+    levelRng = rng;
+    densityScale = density;
+    repairs = 0;
+    maze.assign(side, std::vector<int>(side, 1));
+
+    sf::Clock clock;
+    generateRooms();
+    timings.rooms = clock.restart().asSeconds() * 1000.f;
+    connectMainRooms();
+    timings.connect = clock.restart().asSeconds() * 1000.f;
+    createOpenAreas();
+    timings.openAreas = clock.restart().asSeconds() * 1000.f;
+    addMazeFeatures();
+    timings.features = clock.restart().asSeconds() * 1000.f;
+
+    // Later stages can cut pockets off again; join them instead of retrying
+    repairConnectivity();
+    timings.connect += clock.restart().asSeconds() * 1000.f;
+}
+
+//scales a per-level count to this chunk's share; the fraction is rolled
+//so the expected total over all chunks matches the unchunked level
+int LevelGenerator::scaledCount(int fullCount, Rng& rng) const {
+    float scaled = fullCount * densityScale;
+    int count = static_cast<int>(scaled);
+    float fraction = scaled - count;
+    if (fraction > 0.f && rng.chance(fraction)) count++;
+    return count;
+}
+
+//joins every chunk to its right and lower neighbour
+void LevelGenerator::stitchChunks(int chunks, int side) {
+    PROFILE_SCOPE("LevelGenerator::stitchChunks");
+    for (int cy = 0; cy < chunks; cy++) {
+        for (int cx = 0; cx < chunks; cx++) {
+            if (cx + 1 < chunks) stitchSeam(cx * side, cy * side, side, true);
+            if (cy + 1 < chunks) stitchSeam(cx * side, cy * side, side, false);
+        }
+    }
+}
+
+//carves the shortest L-shaped corridor across the seam after the chunk at
+//origin, towards the right (acrossX) or downwards; earliest lines win ties
+void LevelGenerator::stitchSeam(int originX, int originY, int side, bool acrossX) {
+    auto isFloor = [&](int along, int across) {
+        return acrossX ? maze[originY + along][originX + across] == 0
+                       : maze[originY + across][originX + along] == 0;
+    };
+
+    // Floor closest to the seam on every line, on both sides
+    std::vector<int> before(side, -1);
+    std::vector<int> after(side, -1);
+    for (int along = 1; along < side - 1; along++) {
+        for (int across = side - 2; across >= 1; across--) {
+            if (isFloor(along, across)) { before[along] = across; break; }
+        }
+        for (int across = side + 1; across <= 2 * side - 2; across++) {
+            if (isFloor(along, across)) { after[along] = across; break; }
+        }
+    }
+
+    int bestCost = -1;
+    int bestFrom = 0, bestTo = 0;
+    for (int from = 1; from < side - 1; from++) {
+        if (before[from] < 0) continue;
+        for (int to = 1; to < side - 1; to++) {
+            if (after[to] < 0) continue;
+            int cost = std::abs(from - to) + after[to] - before[from];
+            if (bestCost < 0 || cost < bestCost) {
+                bestCost = cost;
+                bestFrom = from;
+                bestTo = to;
+            }
+        }
+    }
+    if (bestCost < 0) return;
+
+    // connectPoints runs along x first, so start on the side that keeps the
+    // bend inside a chunk instead of on the seam
+    if (acrossX) {
+        connectPoints({ originX + before[bestFrom], originY + bestFrom }, { originX + after[bestTo], originY + bestTo });
+    }
+    else {
+        connectPoints({ originX + bestFrom, originY + before[bestFrom] }, { originX + bestTo, originY + after[bestTo] });
+    }
+}
+
+//carves the shortest corridors joining regions left disconnected
+void LevelGenerator::repairConnectivity() {
+    PROFILE_SCOPE("LevelGenerator::repairConnectivity");
+    regions.build(maze);
+    if (regions.regionCount() <= 1) return;
+
+    for (const auto& link : connector.findLinks(maze, regions)) {
+        connectPoints(link.from, link.to);
+        repairs++;
+    }
+
+    // Links form a spanning tree, so the relabelled maze is one region
+    regions.build(maze);
+}
+
+//generates rooms 
+void LevelGenerator::generateRooms() {
+    PROFILE_SCOPE("LevelGenerator::generateRooms");
+    Rng rng = levelRng.split(Rng::Rooms);
+    int maxPos = static_cast<int>(maze.size()) - 3;
+
+    int roomCount = scaledCount(12 + (currentLevel * 3), rng); // More rooms
+
+    for (int i = 0; i < roomCount; i++) {
+        int roomWidth = rng.range(minRoomSize, maxRoomSize);
+        int roomHeight = rng.range(minRoomSize, maxRoomSize);
+        int x = rng.range(2, maxPos);
+        int y = rng.range(2, maxPos);
+
+        // Ensure room stays within bounds
+        x = std::max(2, std::min(x, static_cast<int>(maze[0].size()) - roomWidth - 2));
+        y = std::max(2, std::min(y, static_cast<int>(maze.size()) - roomHeight - 2));
+
+        // More varied room shapes
+        if (rng.range(0, 10) > 7) { // 30% chance for non-rectangular rooms
+            createCircularRoom(x, y, roomWidth, roomHeight);
+        }
+        else {
+            createRectRoom(x, y, roomWidth, roomHeight);
+        }
+    }
+}
+
+//connects therooms for the player to move through
+void LevelGenerator::connectRooms() {
+    std::vector<sf::Vector2i> roomCenters;
+
+    // Find room centers (simplified version)
+    for (int y = 1; y < maze.size() - 1; y++) {
+        for (int x = 1; x < maze[y].size() - 1; x++) {
+            if (maze[y][x] == 0) {
+                roomCenters.emplace_back(x, y);
+            }
+        }
+    }
+
+    // Connect rooms
+    if (!roomCenters.empty()) {
+        for (size_t i = 1; i < roomCenters.size(); i++) {
+            connectPoints(roomCenters[i - 1], roomCenters[i]);
+        }
+    }
+}
+
+//adds features to the maze
+void LevelGenerator::connectPoints(sf::Vector2i p1, sf::Vector2i p2) {
+    // Horizontal connection
+    int stepX = p1.x < p2.x ? 1 : -1;
+    for (int x = p1.x; x != p2.x; x += stepX) {
+        for (int dy = -corridorWidth / 2; dy <= corridorWidth / 2; dy++) {
+            int y = p1.y + dy;
+            if (y > 0 && y < maze.size() - 1 && x > 0 && x < maze[y].size() - 1) {
+                maze[y][x] = 0;
+            }
+        }
+    }
+
+    // Vertical connection
+    int stepY = p1.y < p2.y ? 1 : -1;
+    for (int y = p1.y; y != p2.y; y += stepY) {
+        for (int dx = -corridorWidth / 2; dx <= corridorWidth / 2; dx++) {
+            int x = p2.x + dx;
+            if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
+                maze[y][x] = 0;
+            }
+        }
+    }
+}
+
+//ensures open areas are created
+void LevelGenerator::createOpenAreas() {
+    PROFILE_SCOPE("LevelGenerator::createOpenAreas");
+    Rng rng = levelRng.split(Rng::OpenAreas);
+    int maxPos = static_cast<int>(maze.size()) - 2;
+
+    int areaCount = scaledCount(3 + (currentLevel / 2), rng);
+    for (int i = 0; i < areaCount; i++) {
+        int size = rng.range(5, 15);
+        int x = rng.range(1, maxPos);
+        int y = rng.range(1, maxPos);
+
+        for (int dy = -size; dy <= size; dy++) {
+            for (int dx = -size; dx <= size; dx++) {
+                if (dx * dx + dy * dy <= size * size) {
+                    int nx = x + dx;
+                    int ny = y + dy;
+                    if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
+                        maze[ny][nx] = 0;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//special areas are created but not used in game , fur further update i am including this
+void LevelGenerator::placeSpecialAreas() {
+    Rng rng = levelRng.split(Rng::Features);
+    int maxPos = static_cast<int>(maze.size()) - 2;
+
+    int specialCount = rng.range(3, 5);
+    for (int i = 0; i < specialCount; i++) {
+        int x = rng.range(1, maxPos);
+        int y = rng.range(1, maxPos);
+
+        // Find open space
+        while (y < maze.size() && x < maze[y].size() && maze[y][x] == 1) {
+            x = rng.range(1, maxPos);
+            y = rng.range(1, maxPos);
+        }
+
+        // Create 5x5 area
+        for (int dy = -2; dy <= 2; dy++) {
+            for (int dx = -2; dx <= 2; dx++) {
+                int nx = x + dx;
+                int ny = y + dy;
+                if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
+                    maze[ny][nx] = 0;
+                    if (dx == 0 && dy == 0) {
+                        maze[ny][nx] = 2; // Mark center as special
+                    }
+                }
+            }
+        }
+    }
+}
+
+//places the player in the maze
+void LevelGenerator::placePlayer() {
+    Rng rng = levelRng.split(Rng::Placement);
+
+    // repairConnectivity leaves a single region, so any floor tile will do
+    Bitboard floor = Bitboard::fromGrid(maze);
+
+    int x = 1;
+    int y = 1;
+    floor.select(rng.range(0, floor.count() - 1), x, y);
+    playerPosition = sf::Vector2f(x * tileSize + tileSize / 2, y * tileSize + tileSize / 2);
+
+    // Everything else is placed by path distance from the start
+    placement.build(floor, { x, y });
+}
+
+//places the exit in the maze
+void LevelGenerator::placeExit() {
+    // Own stream so the exit does not depend on how many player rolls were made
+    Rng rng = levelRng.split(Rng::Placement).split(1);
+
+    // Far along the actual path, not just in a straight line
+    int minDistance = static_cast<int>(maze.size() * 0.4f);
+    sf::Vector2i tile = placement.pick(rng, minDistance);
+    exitPosition = sf::Vector2f(tile.x * tileSize, tile.y * tileSize);
+}
+
+//picks random enemy spawns
+void LevelGenerator::spawnEnemies() {
+    PROFILE_SCOPE("LevelGenerator::spawnEnemies");
+    enemySpawns.clear();
+    int enemyCount = baseEnemies + (currentLevel - 1) * enemiesIncreasePerLevel;
+
+    auto weights = getLevelSpawnWeights(currentLevel);
+    float totalWeight = weights.basic + weights.fast + weights.tank + weights.ranged;
+
+    Rng rng = levelRng.split(Rng::Enemies);
+    int size = static_cast<int>(maze.size());
+    PlacementField::Disks spread(enemySpacing, size, size);
+
+    for (int i = 0; i < enemyCount; i++) {
+        // Only tiles the player can reach, spread out and off the start
+        sf::Vector2i tile = placement.sample(rng, minEnemyDistance, spread);
+        sf::Vector2f pos(tile.x * tileSize + tileSize / 2, tile.y * tileSize + tileSize / 2);
+
+        // Determine enemy type
+        float typeRoll = rng.range(0.0f, totalWeight);
+        Enemy::EnemyType type;
+
+        if (typeRoll < weights.basic) {
+            type = Enemy::BASIC;
+        }
+        else if (typeRoll < weights.basic + weights.fast) {
+            type = Enemy::FAST;
+        }
+        else if (typeRoll < weights.basic + weights.fast + weights.tank) {
+            type = Enemy::TANK;
+        }
+        else {
+            type = Enemy::RANGED;
+        }
+
+        // Apply level scaling
+        float health = rng.range(80.0f, 120.0f) * getHealthMultiplier(currentLevel);
+        enemySpawns.push_back({ pos, health, type });
+    }
+}
+
+// Spawn collectables in the maze
+void LevelGenerator::spawnCollectables() {
+    PROFILE_SCOPE("LevelGenerator::spawnCollectables");
+    Rng rng = levelRng.split(Rng::Collectables);
+    int size = static_cast<int>(maze.size());
+
+    collectables.clear();
+
+    // Calculate base powerup count based on level and enemies
+    int baseCount = 3 + (currentLevel / 3); // Minimum 3, +1 every 3 levels
+    int enemyBasedCount = static_cast<int>(enemySpawns.size()) / 3;
+    int toSpawn = std::min(baseCount + enemyBasedCount, 8); // Cap at 8 powerups
+
+    // Minimum 2 tiles apart and 3 steps from the player
+    PlacementField::Disks spread(2.f, size, size);
+
+    for (int i = 0; i < toSpawn; i++) {
+        sf::Vector2i tile = placement.sample(rng, 3, spread);
+
+        // Adjust spawn weights based on level
+        Collectable::Type type;
+        float value;
+
+        // Higher levels get more powerful powerups
+        if (currentLevel > 5) {
+            // 50% chance for combat powerups in later levels
+            int weightedRoll = rng.range(0, currentLevel > 10 ? 9 : 14);
+            if (weightedRoll < 5) {
+                type = static_cast<Collectable::Type>(rng.range(2, 4)); // DAMAGE, SPEED, or FIRE_RATE
+            }
+            else {
+                type = static_cast<Collectable::Type>(rng.range(0, 1)); // HEALTH or MANA
+            }
+
+            // Scale values with level
+            value = rng.range(10.f, 30.f) * (1.0f + currentLevel * 0.05f);
+        }
+        else {
+            type = static_cast<Collectable::Type>(rng.range(0, 4));
+            value = rng.range(10.f, 30.f);
+        }
+
+        // Double health values
+        if (type == Collectable::Type::HEALTH) {
+            value *= 2.0f;
+        }
+
+        collectables.push_back({
+            sf::Vector2f(tile.x * tileSize + tileSize / 2, tile.y * tileSize + tileSize / 2),
+            type,
+            value
+        });
+    }
+}
+
+//spawns enemies with different variables
+LevelGenerator::EnemySpawnWeights LevelGenerator::getLevelSpawnWeights(int level) {
+    EnemySpawnWeights weights;
+
+    // Use explicit float versions of min/max
+    weights.basic = std::max<float>(10.0f, 60.0f - level * 3.0f);
+    weights.fast = 20.0f + std::min<float>(20.0f, level * 2.0f) - std::max<float>(0.0f, (level - 5.0f) * 1.5f);
+    weights.tank = 5.0f + level * 1.5f;
+    weights.ranged = std::min<float>(30.0f, std::max<float>(0.0f, level - 3) * 4.0f);
+
+    return weights;
+}
+
+float LevelGenerator::getHealthMultiplier(int level) {
+    return 1.0f + (level * 0.1f); // +10% health per level
+}
+
+float LevelGenerator::getDamageMultiplier(int level) {
+    return 1.0f + (level * 0.07f); // +7% damage per level
+}
+
+float LevelGenerator::getSpeedMultiplier(int level) {
+    return 1.0f + (level * 0.03f); // +3% speed per level
+}
+
+//creates deadends in the maze
+void LevelGenerator::addDeadEnds() {
+    Rng rng = levelRng.split(Rng::DeadEnds);
+    int maxPos = static_cast<int>(maze.size()) - 2;
+    int count = rng.range(5, 10 + currentLevel);
+
+    for (int i = 0; i < count; i++) {
+        int x = rng.range(1, maxPos);
+        int y = rng.range(1, maxPos);
+        int direction = rng.range(0, 3);
+        int length = rng.range(3, 8);
+
+        // Find a wall adjacent to a path
+        bool foundStart = false;
+        for (int tries = 0; tries < 20 && !foundStart; tries++) {
+            x = rng.range(1, maxPos);
+            y = rng.range(1, maxPos);
+
+            if (maze[y][x] == 1) {
+                // Check if adjacent to a path
+                for (int dy = -1; dy <= 1; dy++) {
+                    for (int dx = -1; dx <= 1; dx++) {
+                        if (dx == 0 && dy == 0) continue;
+                        int nx = x + dx;
+                        int ny = y + dy;
+                        if (nx > 0 && nx < maze[0].size() - 1 && ny > 0 && ny < maze.size() - 1) {
+                            if (maze[ny][nx] == 0) {
+                                foundStart = true;
+                                break;
+                            }
+                        }
+                    }
+                    if (foundStart) break;
+                }
+            }
+        }
+
+        if (foundStart) {
+            for (int j = 0; j < length; j++) {
+                if (x > 0 && x < maze[0].size() - 1 && y > 0 && y < maze.size() - 1) {
+                    maze[y][x] = 0;
+                    switch (direction) {
+                    case 0: x++; break;
+                    case 1: x--; break;
+                    case 2: y++; break;
+                    case 3: y--; break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+//creates winding paths in the maze
+void LevelGenerator::addDiagonalPaths() {
+    Rng rng = levelRng.split(Rng::Features).split(1);
+    int maxPos = static_cast<int>(maze.size()) - 2;
+    int count = rng.range(3, 5 + currentLevel / 2);
+
+    for (int i = 0; i < count; i++) {
+        int x1 = rng.range(1, maxPos);
+        int y1 = rng.range(1, maxPos);
+        int x2 = rng.range(1, maxPos);
+        int y2 = rng.range(1, maxPos);
+
+        // Ensure both ends are in walkable areas
+        if (maze[y1][x1] == 0 && maze[y2][x2] == 0) {
+            int dx = (x2 > x1) ? 1 : -1;
+            int dy = (y2 > y1) ? 1 : -1;
+
+            while (x1 != x2 && y1 != y2) {
+                x1 += dx;
+                y1 += dy;
+                if (x1 > 0 && x1 < maze[0].size() - 1 && y1 > 0 && y1 < maze.size() - 1) {
+                    maze[y1][x1] = 0;
+                    // Add some width to the diagonal
+                    if (rng.range(0, 1) == 0 && x1 + dx > 0 && x1 + dx < maze[0].size() - 1) maze[y1][x1 + dx] = 0;
+                    if (rng.range(0, 1) == 0 && y1 + dy > 0 && y1 + dy < maze.size() - 1) maze[y1 + dy][x1] = 0;
+                }
+            }
+        }
+    }
+}
+
+//adds features
+void LevelGenerator::addMazeFeatures() {
+    PROFILE_SCOPE("LevelGenerator::addMazeFeatures");
+    Rng rng = levelRng.split(Rng::Features);
+
+    // Add winding paths
+    int windingPaths = scaledCount(5 + currentLevel, rng);
+    for (int i = 0; i < windingPaths; i++) {
+        createWindingPath(rng);
+    }
+
+    // Add some dead ends
+    int deadEnds = scaledCount(3 + currentLevel, rng);
+    for (int i = 0; i < deadEnds; i++) {
+        createDeadEnd(rng);
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "JobSystem.h"
+#include "Level.h"
+#include "PlacementField.h"
+#include "RegionMap.h"
+#include "RoomConnector.h"
+#include "Rng.h"
+
+// Builds levels from (level number, seed). Holds no reference to the running
+// game, so one instance can work on a background thread.
+class LevelGenerator {
+public:
+    static constexpr float tileSize = 32.f;
+
+    // Chunks are generated on the given pool, or the shared one if null
+    explicit LevelGenerator(JobSystem* jobs = nullptr);
+
+    std::unique_ptr<Level> generate(int levelNumber, std::uint64_t seed);
+
+    // ===== Difficulty Scaling =====
+    struct EnemySpawnWeights {
+        float basic;
+        float fast;
+        float tank;
+        float ranged;
+    };
+    static EnemySpawnWeights getLevelSpawnWeights(int level);
+    static float getHealthMultiplier(int level);
+    static float getDamageMultiplier(int level);
+    static float getSpeedMultiplier(int level);
+
+private:
+    // ===== Maze Generation Constants =====
+    static const int baseSize = 60;
+    static const int sizeIncreasePerLevel = 12;
+    static const int minRoomSize = 8;
+    static const int maxRoomSize = 18;
+    static const int corridorWidth = 5;
+    static const int baseEnemies = 3;
+    static const int enemiesIncreasePerLevel = 2;
+    // Spawn spacing in tiles, and path distance kept clear around the start
+    static constexpr float enemySpacing = 4.f;
+    static const int minEnemyDistance = 6;
+    // Smallest chunk side; big enough for the largest room and open area
+    static const int minChunkSize = 96;
+
+    // ===== Level Being Built =====
+    JobSystem* jobs;
+    int currentLevel = 1;
+    std::uint64_t seed = 0;
+    Rng levelRng;  // root stream of the level being generated
+    float densityScale = 1.f; // share of the level's rooms and features in the current grid
+    int repairs = 0; // corridors carved by repairConnectivity
+    RoomConnector connector;
+    // The whole level is built here (4 bytes a tile) before it is packed
+    // into a TileMap, so the peak while generating grows with the area even
+    // though the finished level does not; mazegen reports both per level.
+    // Released once the level is handed out.
+    std::vector<std::vector<int>> maze;
+    RegionMap regions;
+    PlacementField placement; // path distances from the player start
+    sf::Vector2f playerPosition;
+    sf::Vector2f exitPosition;
+    std::vector<Level::EnemySpawn> enemySpawns;
+    std::vector<Level::CollectableSpawn> collectables;
+    Level::StageTimes timings;
+
+    // ===== Maze Generation =====
+    void generateMaze();
+    static int chunksPerSide(int size);
+    void buildChunk(int levelNumber, const Rng& rng, int side, float density);
+    void stitchChunks(int chunks, int side);
+    void stitchSeam(int originX, int originY, int side, bool acrossX);
+    int scaledCount(int fullCount, Rng& rng) const;
+    void repairConnectivity();
+    void generateRooms();
+    void connectRooms();
+    void connectMainRooms();
+    void createOpenAreas();
+    void placeSpecialAreas();
+    void createRectRoom(int x, int y, int width, int height);
+    void createCircularRoom(int x, int y, int width, int height);
+    void createWindingPath(Rng& rng);
+    void createDeadEnd(Rng& rng);
+    void connectPoints(sf::Vector2i p1, sf::Vector2i p2);
+    void addDeadEnds();
+    void addDiagonalPaths();
+    void addMazeFeatures();
+
+    // ===== Placement =====
+    void placePlayer();
+    void placeExit();
+    void spawnEnemies();
+    void spawnCollectables();
+};
@@ -0,0 +1,92 @@
+#include "LevelPrefetcher.h"
+#include "LevelFile.h"
+#include "Profiler.h"
+#include <utility>
+
+LevelPrefetcher::LevelPrefetcher() {
+    worker = std::thread(&LevelPrefetcher::workerLoop, this);
+}
+
+LevelPrefetcher::~LevelPrefetcher() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void LevelPrefetcher::setLevelPack(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    levelPack = directory;
+}
+
+void LevelPrefetcher::request(int levelNumber, std::uint64_t seed) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (ready && ready->number == levelNumber && ready->seed == seed) return;
+
+        hasRequest = true;
+        requestedLevel = levelNumber;
+        requestedSeed = seed;
+    }
+    wake.notify_one();
+}
+
+std::unique_ptr<Level> LevelPrefetcher::take(int levelNumber, std::uint64_t seed) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!ready || ready->number != levelNumber || ready->seed != seed) {
+        return nullptr;
+    }
+    return std::move(ready);
+}
+
+std::unique_ptr<Level> LevelPrefetcher::wait(int levelNumber, std::uint64_t seed) {
+    PROFILE_SCOPE("LevelPrefetcher::wait");
+    std::unique_lock<std::mutex> lock(mutex);
+    auto isReady = [&] { return ready && ready->number == levelNumber && ready->seed == seed; };
+    finished.wait(lock, [&] { return isReady() || !isPending(levelNumber, seed); });
+    if (!isReady()) return nullptr;
+    return std::move(ready);
+}
+
+bool LevelPrefetcher::isPending(int levelNumber, std::uint64_t seed) const {
+    return (hasRequest && requestedLevel == levelNumber && requestedSeed == seed) ||
+        (building && buildingLevel == levelNumber && buildingSeed == seed);
+}
+
+//waits for requests and generates them one at a time
+void LevelPrefetcher::workerLoop() {
+    Profiler::setThreadName("level prefetch");
+    while (true) {
+        int levelNumber;
+        std::uint64_t seed;
+        std::string pack;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || hasRequest; });
+            if (stopping) return;
+
+            levelNumber = requestedLevel;
+            seed = requestedSeed;
+            pack = levelPack;
+            hasRequest = false;
+            building = true;
+            buildingLevel = levelNumber;
+            buildingSeed = seed;
+        }
+
+        // Generate without holding the lock so take() stays non-blocking
+        std::unique_ptr<Level> level = LevelFile::loadOrGenerate(generator, pack, levelNumber, seed);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            building = false;
+            // Drop the result if a newer request came in meanwhile
+            if (!hasRequest) {
+                ready = std::move(level);
+            }
+        }
+        finished.notify_all();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "Level.h"
+#include "LevelGenerator.h"
+
+// Generates the next level on a worker thread while the current one is
+// played. Game asks for a level with request() and picks it up with
+// wait(), which blocks while that level is still being built; only a level
+// that was never requested is generated by Game itself.
+class LevelPrefetcher {
+public:
+    LevelPrefetcher();
+    ~LevelPrefetcher();
+
+    LevelPrefetcher(const LevelPrefetcher&) = delete;
+    LevelPrefetcher& operator=(const LevelPrefetcher&) = delete;
+
+    // Directory of pre-generated levels to load from before generating
+    void setLevelPack(const std::string& directory);
+
+    // Queues a level for generation, replacing any older request
+    void request(int levelNumber, std::uint64_t seed);
+
+    // Finished level if it matches, nullptr otherwise. Never blocks on generation.
+    std::unique_ptr<Level> take(int levelNumber, std::uint64_t seed);
+    // Same, but waits for the level when it is queued or being built.
+    // nullptr only when it was never requested or a newer request replaced it.
+    std::unique_ptr<Level> wait(int levelNumber, std::uint64_t seed);
+
+private:
+    void workerLoop();
+    // Queued or being built right now; call with mutex held
+    bool isPending(int levelNumber, std::uint64_t seed) const;
+
+    LevelGenerator generator; // only touched by the worker
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    bool stopping = false;
+
+    // Guarded by mutex
+    bool hasRequest = false;
+    int requestedLevel = 0;
+    std::uint64_t requestedSeed = 0;
+    bool building = false;
+    int buildingLevel = 0;
+    std::uint64_t buildingSeed = 0;
+    std::string levelPack;
+    std::unique_ptr<Level> ready;
+};
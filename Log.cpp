@@ -0,0 +1,256 @@
+#include "Log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace {
+    const char* const levelNames[] = { "trace", "debug", "info", "warn", "error", "off" };
+    const char* const categoryNames[Log::CategoryCount] = {
+        "general",
+        "game",
+        "player",
+        "enemies",
+        "assets",
+        "replay",
+        "profiling"
+    };
+
+    struct Entry {
+        std::int64_t time;
+        std::uint32_t thread;
+        std::uint8_t level;
+        std::uint8_t category;
+        std::uint16_t length;
+        char text[Log::Line::capacity];
+    };
+
+    // Bounded multi-producer queue: a slot's sequence says whose turn it is.
+    // It equals the write position while free, position + 1 once written
+    // and position + ringSize after the writer thread has taken it.
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        Entry entry;
+    };
+
+    const std::uint64_t ringSize = 1024; // power of two
+
+    struct State {
+        std::atomic<int> levels[Log::CategoryCount];
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+        std::atomic<std::uint32_t> nextThread{ 0 };
+
+        Slot slots[ringSize];
+        std::atomic<std::uint64_t> tail{ 0 }; // next position to write
+        std::uint64_t head = 0;               // next position to read, writer thread only
+        std::atomic<std::uint64_t> lost{ 0 };
+
+        std::atomic<bool> running{ false };
+        std::atomic<bool> stopping{ false };
+        std::ofstream file;
+        std::thread writer;
+        std::mutex mutex; // open/close, and stderr before open
+
+        State() {
+            for (auto& level : levels) level.store(Log::Info, std::memory_order_relaxed);
+            for (std::uint64_t i = 0; i < ringSize; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+        ~State() {
+            if (!writer.joinable()) return;
+            stopping.store(true, std::memory_order_release);
+            writer.join();
+        }
+    };
+
+    State& state() {
+        static State instance;
+        return instance;
+    }
+
+    std::uint32_t threadNumber() {
+        thread_local std::uint32_t number = state().nextThread.fetch_add(1, std::memory_order_relaxed);
+        return number;
+    }
+
+    bool push(State& log, const Entry& entry) {
+        std::uint64_t position = log.tail.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = log.slots[position & (ringSize - 1)];
+            std::uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            std::int64_t difference = static_cast<std::int64_t>(sequence - position);
+            if (difference == 0) {
+                if (log.tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.entry = entry;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0) {
+                return false; // a full lap behind: the ring is full
+            }
+            else {
+                position = log.tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(State& log, Entry& entry) {
+        Slot& slot = log.slots[log.head & (ringSize - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != log.head + 1) return false;
+        entry = slot.entry;
+        slot.sequence.store(log.head + ringSize, std::memory_order_release);
+        log.head++;
+        return true;
+    }
+
+    void format(const Entry& entry, std::ostream& out) {
+        char prefix[64];
+        std::snprintf(prefix, sizeof(prefix), "%10.3f %-5s %s/%u: ", entry.time / 1e9,
+            levelNames[entry.level], categoryNames[entry.category], entry.thread);
+        out << prefix;
+        out.write(entry.text, entry.length);
+        out << '\n';
+    }
+
+    void writeLoop(State& log) {
+        std::uint64_t reportedLost = 0;
+        Entry entry;
+        for (;;) {
+            // Read first: everything queued before close() is drained below
+            bool stopping = log.stopping.load(std::memory_order_acquire);
+            bool wrote = false;
+            while (pop(log, entry)) {
+                format(entry, log.file);
+                if (entry.level >= Log::Warn) format(entry, std::cerr);
+                wrote = true;
+            }
+            std::uint64_t lost = log.lost.load(std::memory_order_relaxed);
+            if (lost != reportedLost) {
+                log.file << "(" << lost - reportedLost << " messages dropped, ring full)\n";
+                reportedLost = lost;
+                wrote = true;
+            }
+            if (wrote) log.file.flush();
+            if (stopping) break;
+            if (!wrote) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+}
+
+const char* Log::name(Level level) {
+    return levelNames[level];
+}
+
+const char* Log::name(Category category) {
+    return categoryNames[category];
+}
+
+bool Log::parseLevel(const std::string& text, Level& level) {
+    for (int i = Trace; i <= Off; i++) {
+        if (text == levelNames[i]) {
+            level = static_cast<Level>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Log::parseCategory(const std::string& text, Category& category) {
+    for (int i = 0; i < CategoryCount; i++) {
+        if (text == categoryNames[i]) {
+            category = static_cast<Category>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void Log::setLevel(Level level) {
+    for (auto& threshold : state().levels) threshold.store(level, std::memory_order_relaxed);
+}
+
+void Log::setLevel(Category category, Level level) {
+    state().levels[category].store(level, std::memory_order_relaxed);
+}
+
+bool Log::isEnabled(Level level, Category category) {
+    return level >= state().levels[category].load(std::memory_order_relaxed);
+}
+
+bool Log::open(const std::string& path) {
+    close();
+    State& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.file.open(path, std::ios::trunc);
+    if (!log.file.is_open()) return false;
+    log.stopping.store(false, std::memory_order_relaxed);
+    log.writer = std::thread(writeLoop, std::ref(log));
+    log.running.store(true, std::memory_order_release);
+    return true;
+}
+
+void Log::close() {
+    State& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    if (!log.writer.joinable()) return;
+    log.running.store(false, std::memory_order_release);
+    log.stopping.store(true, std::memory_order_release);
+    log.writer.join();
+    log.file.close();
+}
+
+std::uint64_t Log::dropped() {
+    return state().lost.load(std::memory_order_relaxed);
+}
+
+Log::Line::~Line() {
+    State& log = state();
+    Entry entry;
+    entry.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - log.epoch).count();
+    entry.thread = threadNumber();
+    entry.level = static_cast<std::uint8_t>(level);
+    entry.category = static_cast<std::uint8_t>(category);
+    entry.length = static_cast<std::uint16_t>(length);
+    std::memcpy(entry.text, text, length);
+
+    if (log.running.load(std::memory_order_acquire)) {
+        if (!push(log, entry)) log.lost.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // No writer thread: rare enough (startup, tools) to write right here
+    std::lock_guard<std::mutex> lock(log.mutex);
+    format(entry, std::cerr);
+}
+
+void Log::Line::appendText(const char* value) {
+    while (*value && length < capacity) text[length++] = *value++;
+}
+
+void Log::Line::appendChar(char c) {
+    if (length < capacity) text[length++] = c;
+}
+
+void Log::Line::appendSigned(long long value) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%lld", value);
+    appendText(buffer);
+}
+
+void Log::Line::appendUnsigned(unsigned long long value) {
+    char buffer[24];
+    std::snprintf(buffer, sizeof(buffer), "%llu", value);
+    appendText(buffer);
+}
+
+// Same as the default of std::ostream: six significant digits
+void Log::Line::appendFloat(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%g", value);
+    appendText(buffer);
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Leveled, categorised logging that stays off the frame's critical path.
+// A message is formatted into a fixed-size slot of a lock-free ring buffer
+// and written out by a background thread, so logging never waits on the
+// console or the disk; when the ring is full the message is dropped and
+// counted instead.
+//
+//     LOG_DEBUG(Log::Player, "Took " << damage << " damage");
+//
+// Messages below MAZE_LOG_LEVEL (a Level value, set by CMake) are not
+// compiled in at all; the rest are filtered per category at run time.
+// Before open() messages go straight to stderr.
+class Log {
+public:
+    enum Level {
+        Trace,
+        Debug,
+        Info,
+        Warn,
+        Error,
+        Off
+    };
+
+    enum Category {
+        General,
+        Game,
+        Player,
+        Enemies,
+        Assets,
+        Replay,
+        Profiling,
+        CategoryCount
+    };
+
+    static const char* name(Level level);
+    static const char* name(Category category);
+    // Accepts the names above in lower case; false when unknown
+    static bool parseLevel(const std::string& text, Level& level);
+    static bool parseCategory(const std::string& text, Category& category);
+
+    // Lowest level let through, for one category or all of them; Info
+    // unless changed
+    static void setLevel(Level level);
+    static void setLevel(Category category, Level level);
+    static bool isEnabled(Level level, Category category);
+
+    // Starts the writer thread appending to path. Warnings and errors are
+    // echoed to stderr as well.
+    static bool open(const std::string& path);
+    // Writes what is still queued and stops the writer thread
+    static void close();
+    // Messages lost to a full ring so far
+    static std::uint64_t dropped();
+
+    // One message being built; it is queued when the line goes out of scope
+    class Line {
+    public:
+        static const int capacity = 224;
+
+        Line(Level level, Category category) : level(level), category(category) {}
+        ~Line();
+
+        Line(const Line&) = delete;
+        Line& operator=(const Line&) = delete;
+
+        Line& operator<<(const char* value) {
+            appendText(value);
+            return *this;
+        }
+        Line& operator<<(const std::string& value) {
+            appendText(value.c_str());
+            return *this;
+        }
+
+        template <typename T>
+        Line& operator<<(T value) {
+            static_assert(std::is_arithmetic<T>::value, "Log lines take text and numbers");
+            if constexpr (std::is_same<T, bool>::value) {
+                appendText(value ? "true" : "false");
+            }
+            else if constexpr (std::is_same<T, char>::value) {
+                appendChar(value);
+            }
+            else if constexpr (std::is_floating_point<T>::value) {
+                appendFloat(static_cast<double>(value));
+            }
+            else if constexpr (std::is_signed<T>::value) {
+                appendSigned(static_cast<long long>(value));
+            }
+            else {
+                appendUnsigned(static_cast<unsigned long long>(value));
+            }
+            return *this;
+        }
+
+    private:
+        Level level;
+        Category category;
+        int length = 0;
+        char text[capacity];
+
+        void appendText(const char* value);
+        void appendChar(char c);
+        void appendSigned(long long value);
+        void appendUnsigned(unsigned long long value);
+        void appendFloat(double value);
+    };
+};
+
+#ifndef MAZE_LOG_LEVEL
+#define MAZE_LOG_LEVEL 0
+#endif
+
+#define LOG_AT(level, category, message) \
+    do { \
+        if (Log::isEnabled(level, category)) { \
+            Log::Line logLine(level, category); \
+            logLine << message; \
+        } \
+    } while (0)
+
+#if MAZE_LOG_LEVEL <= 0
+#define LOG_TRACE(category, message) LOG_AT(Log::Trace, category, message)
+#else
+#define LOG_TRACE(category, message) ((void)0)
+#endif
+#if MAZE_LOG_LEVEL <= 1
+#define LOG_DEBUG(category, message) LOG_AT(Log::Debug, category, message)
+#else
+#define LOG_DEBUG(category, message) ((void)0)
+#endif
+#if MAZE_LOG_LEVEL <= 2
+#define LOG_INFO(category, message) LOG_AT(Log::Info, category, message)
+#else
+#define LOG_INFO(category, message) ((void)0)
+#endif
+#if MAZE_LOG_LEVEL <= 3
+#define LOG_WARN(category, message) LOG_AT(Log::Warn, category, message)
+#else
+#define LOG_WARN(category, message) ((void)0)
+#endif
+#if MAZE_LOG_LEVEL <= 4
+#define LOG_ERROR(category, message) LOG_AT(Log::Error, category, message)
+#else
+#define LOG_ERROR(category, message) ((void)0)
+#endif
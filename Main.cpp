@@ -1,7 +1,209 @@
 #include "Game.h"
+#include "Log.h"
+#include "Metrics.h"
+#include "BotInput.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "ScriptedInput.h"
+#include <cctype>
+#include <cmath>
+#include <exception>
+#include <string>
+#include <random>
+#include <iostream>
 
-int main() {
-    Game game;
-    game.run();
+namespace {
+    // The whole of text as a number; false on anything else or overflow
+    template <typename T, typename Parse>
+    bool parseWith(const std::string& text, T& value, Parse parse) {
+        try {
+            size_t used = 0;
+            T parsed = parse(text, &used);
+            if (used != text.size()) return false;
+            value = parsed;
+            return true;
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    bool parseNumber(const std::string& text, std::uint64_t& value) {
+        // stoull would quietly wrap "-1" around
+        if (text.empty() || !std::isdigit(static_cast<unsigned char>(text[0]))) return false;
+        return parseWith(text, value, [](const std::string& s, size_t* used) { return std::stoull(s, used); });
+    }
+
+    bool parseNumber(const std::string& text, int& value) {
+        return parseWith(text, value, [](const std::string& s, size_t* used) { return std::stoi(s, used); });
+    }
+
+    // stof also takes "inf" and "nan", which no option means
+    bool parseNumber(const std::string& text, float& value) {
+        float parsed = 0.f;
+        if (!parseWith(text, parsed, [](const std::string& s, size_t* used) { return std::stof(s, used); })) return false;
+        if (!std::isfinite(parsed)) return false;
+        value = parsed;
+        return true;
+    }
+
+    int invalidValue(const std::string& option, const std::string& value) {
+        std::cerr << "Invalid value for " << option << ": " << value << std::endl;
+        return 1;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --seed <n> reproduces a run, --level-pack <dir> loads levels from (and
+    // saves new ones to) a directory, --sim-hz <n> sets the simulation step
+    // rate (default 60), --headless [ticks] runs that many steps without a
+    // window and prints the step rate. --bot hands the player to the
+    // autopilot, --script <file> replays an input timeline (see
+    // ScriptedInput.h). --record <file> saves the run as a replay and
+    // --replay <file> plays one back, checking it stays on track; with
+    // --headless it runs at full speed. --trace <file> records timers from
+    // the start and saves the last frames as a Chrome trace on exit.
+    // --metrics <file> saves per-frame counters as CSV, or JSON when the
+    // name ends in .json; headless runs then draw their frames to count them.
+    // --hitch-budget <ms> sets how slow a frame may get before the seconds
+    // before it are saved to hitches/ (default 25, 0 turns it off).
+    // --log <file> picks the log file (default game.log), --log-level
+    // <level> or <category>=<level> what goes into it (see Log.h).
+    // Offline generation lives in mazegen.
+    std::uint64_t seed = std::random_device{}();
+    std::string levelPack;
+    float simulationRate = 0.f;
+    bool headless = false;
+    int headlessTicks = 0;
+    std::unique_ptr<InputSource> input;
+    std::string recordPath;
+    std::unique_ptr<Replay> replay;
+    std::string traceFile;
+    std::string metricsFile;
+    float hitchBudget = -1.f;
+    std::string logFile = "game.log";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], seed)) return invalidValue(arg, argv[i]);
+        }
+        else if (arg == "--level-pack" && i + 1 < argc) {
+            levelPack = argv[++i];
+        }
+        else if (arg == "--sim-hz" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], simulationRate) || simulationRate <= 0.f) return invalidValue(arg, argv[i]);
+        }
+        else if (arg == "--headless") {
+            headless = true;
+            if (i + 1 < argc && std::isdigit(static_cast<unsigned char>(argv[i + 1][0]))) {
+                if (!parseNumber(argv[++i], headlessTicks)) return invalidValue(arg, argv[i]);
+            }
+        }
+        else if (arg == "--bot") {
+            input = std::make_unique<BotInput>();
+        }
+        else if (arg == "--script" && i + 1 < argc) {
+            auto script = std::make_unique<ScriptedInput>();
+            if (!script->loadFromFile(argv[++i])) return 1;
+            input = std::move(script);
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        }
+        else if (arg == "--metrics" && i + 1 < argc) {
+            metricsFile = argv[++i];
+        }
+        else if (arg == "--hitch-budget" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], hitchBudget)) return invalidValue(arg, argv[i]);
+        }
+        else if (arg == "--log" && i + 1 < argc) {
+            logFile = argv[++i];
+        }
+        else if (arg == "--log-level" && i + 1 < argc) {
+            std::string setting = argv[++i];
+            size_t equals = setting.find('=');
+            Log::Category category = Log::General;
+            Log::Level level = Log::Info;
+            bool valid = equals == std::string::npos ? Log::parseLevel(setting, level) :
+                Log::parseCategory(setting.substr(0, equals), category) && Log::parseLevel(setting.substr(equals + 1), level);
+            if (!valid) {
+                std::cerr << "Unknown log level " << setting << std::endl;
+                return 1;
+            }
+            if (equals == std::string::npos) Log::setLevel(level);
+            else Log::setLevel(category, level);
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replay = Replay::load(argv[++i]);
+            if (!replay) {
+                std::cerr << "Cannot read replay " << argv[i] << std::endl;
+                return 1;
+            }
+            seed = replay->seed;
+        }
+    }
+    if (headlessTicks <= 0) {
+        headlessTicks = replay ? static_cast<int>(replay->steps) : 3600;
+    }
+
+    std::cout << "Seed: " << seed << std::endl;
+    if (!Log::open(logFile)) {
+        std::cerr << "Cannot write log " << logFile << std::endl;
+    }
+    Profiler::setEnabled(!traceFile.empty());
+    Metrics::setRecording(!metricsFile.empty());
+    Game game(seed, levelPack, headless);
+    game.setSimulationRate(simulationRate);
+    if (hitchBudget >= 0.f) game.setHitchBudget(hitchBudget);
+    game.setInputSource(std::move(input));
+
+    Replay recorded;
+    if (replay) {
+        game.playBack(*replay);
+    }
+    else if (!recordPath.empty()) {
+        game.record(recorded);
+    }
+
+    if (headless) {
+        game.runHeadless(headlessTicks, !metricsFile.empty());
+    }
+    else {
+        game.run();
+    }
+
+    if (!traceFile.empty() && !Profiler::writeChromeTrace(traceFile)) {
+        std::cerr << "Cannot write trace " << traceFile << std::endl;
+    }
+    if (!metricsFile.empty()) {
+        bool json = metricsFile.size() >= 5 && metricsFile.compare(metricsFile.size() - 5, 5, ".json") == 0;
+        if (!(json ? Metrics::writeJson(metricsFile) : Metrics::writeCsv(metricsFile))) {
+            std::cerr << "Cannot write metrics " << metricsFile << std::endl;
+        }
+    }
+
+    Log::close();
+
+    if (replay) {
+        if (game.divergedAt() < 0) {
+            std::cout << "Replay matched " << game.checkpointsMatched() << " of "
+                << replay->checkpoints.size() << " checkpoints" << std::endl;
+        }
+        else {
+            std::cout << "Replay diverged at step " << game.divergedAt() << std::endl;
+            return 2;
+        }
+    }
+    if (!recordPath.empty() && !replay) {
+        if (!recorded.write(recordPath)) {
+            std::cerr << "Cannot write replay " << recordPath << std::endl;
+            return 1;
+        }
+        std::cout << "Recorded " << recorded.steps << " steps to " << recordPath << std::endl;
+    }
     return 0;
 }
@@ -1,15 +1,15 @@
 #include "MainMenu.h"
-#include <iostream>
+#include "Log.h"
 
 MainMenu::MainMenu(sf::RenderWindow& window) {
     // Load font
     if (!font.loadFromFile("assets/arial.ttf")) {
-        std::cerr << "Error loading font file" << std::endl;
+        LOG_ERROR(Log::Assets, "Error loading font file");
     }
 
     // Load background image
     if (!backgroundTexture.loadFromFile("assets/bg.jpg")) {
-        std::cerr << "Error loading background image" << std::endl;
+        LOG_ERROR(Log::Assets, "Error loading background image");
         // Fallback: create a simple color background
         backgroundTexture.create(window.getSize().x, window.getSize().y);
         backgroundTexture.setSmooth(true);
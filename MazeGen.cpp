@@ -0,0 +1,502 @@
+#include "LevelGenerator.h"
+#include "JobSystem.h"
+#include "LevelFile.h"
+#include "PlacementField.h"
+#include "Profiler.h"
+#include "Rng.h"
+#include <SFML/System/Clock.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// Offline level generator: builds a range of levels for a range of seeds in
+// parallel and reports per-stage timings, connectivity and exit distance.
+//
+//   mazegen [--seeds A[-B]] [--levels A[-B]] [--threads N] [--chunk-workers N] [--dump DIR]
+//           [--trace FILE] [--check-edits N]
+//
+// --threads runs whole levels side by side; --chunk-workers sizes the pool
+// that generates the chunks of each level (0 keeps chunks on the level's
+// own thread). Output is the same for any combination. --trace writes the
+// generation stages of every thread as a Chrome trace. --check-edits makes N
+// random tile edits on each level and compares the caches kept current by
+// the edits (regions, wall distance, occupancy, wall boxes, dirty areas)
+// with full rebuilds.
+//
+// Prints one CSV row per level, then a summary. Exits with 1 when any level
+// has an unreachable exit or a cache that went wrong under edits.
+
+namespace {
+    struct Range {
+        std::uint64_t first = 1;
+        std::uint64_t last = 1;
+    };
+
+    struct Result {
+        std::uint64_t seed = 0;
+        int level = 0;
+        int size = 0;
+        Level::StageTimes timings;
+        int repairs = 0;
+        int regions = 0;
+        bool connected = false;
+        int pathLength = -1;
+        int wallTiles = 0;
+        int wallRects = 0; // boxes after greedy meshing
+        // Heap bytes of the finished level by part, and of the generator's
+        // full-size scratch that is still alive while the level is built
+        size_t tileBytes = 0;
+        size_t regionBytes = 0;
+        size_t fieldBytes = 0;
+        size_t pyramidBytes = 0;
+        size_t meshBytes = 0;
+        size_t generatorBytes = 0;
+
+        size_t levelBytes() const { return tileBytes + regionBytes + fieldBytes + pyramidBytes + meshBytes; }
+        bool dumped = false;
+        // Caches that disagreed with a rebuild under --check-edits
+        int cacheErrors = 0;
+        std::string cacheError;
+    };
+
+    bool parseRange(const std::string& text, Range& range) {
+        try {
+            size_t dash = text.find('-');
+            range.first = std::stoull(text.substr(0, dash));
+            range.last = dash == std::string::npos ? range.first : std::stoull(text.substr(dash + 1));
+        }
+        catch (const std::exception&) {
+            return false;
+        }
+        return range.first <= range.last;
+    }
+
+    sf::Vector2i toTile(sf::Vector2f position) {
+        return sf::Vector2i(
+            static_cast<int>(position.x / LevelGenerator::tileSize),
+            static_cast<int>(position.y / LevelGenerator::tileSize));
+    }
+
+    // High-water mark of the process's resident memory, 0 when unknown
+    size_t peakResidentBytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss); // bytes
+#else
+        return static_cast<size_t>(usage.ru_maxrss) * 1024; // kilobytes
+#endif
+#endif
+    }
+
+    // Shortest 4-connected walk from the player start to the exit, -1 if none
+    int exitDistance(const Level& level) {
+        PlacementField field;
+        field.build(level.maze.walkable(), toTile(level.playerStart));
+        return field.distance(toTile(level.exitPosition));
+    }
+
+    // Compares every cache the level keeps current through TileMap listeners
+    // with one built from scratch out of the edited tiles, or with a plain
+    // tile scan. Describes the first mismatch in error; returns the count.
+    int compareCaches(const Level& level, Rng& rng, std::string& error) {
+        const TileMap& tiles = level.maze;
+        const int width = tiles.getWidth();
+        const int height = tiles.getHeight();
+        Bitboard floor = tiles.walkable();
+        int errors = 0;
+        auto fail = [&](const std::string& what, int x, int y) {
+            if (errors++ == 0) error = what + " at " + std::to_string(x) + "," + std::to_string(y);
+        };
+
+        // Same partition of the floor: labels map one to one, sizes agree
+        RegionMap regions;
+        regions.build(floor);
+        if (regions.regionCount() != level.regions.regionCount()) {
+            fail("region count " + std::to_string(level.regions.regionCount()) + " instead of "
+                + std::to_string(regions.regionCount()), 0, 0);
+        }
+        std::unordered_map<int, int> toFresh;
+        std::unordered_map<int, int> fromFresh;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int kept = level.regions.regionOf({ x, y });
+                int fresh = regions.regionOf({ x, y });
+                if ((kept < 0) != (fresh < 0)) {
+                    fail("region walkability", x, y);
+                    continue;
+                }
+                if (kept < 0) continue;
+                auto forward = toFresh.emplace(kept, fresh).first;
+                auto backward = fromFresh.emplace(fresh, kept).first;
+                if (forward->second != fresh || backward->second != kept) {
+                    fail("region label", x, y);
+                }
+                else if (level.regions.regionSize(kept) != regions.regionSize(fresh)) {
+                    fail("region size", x, y);
+                }
+            }
+        }
+
+        DistanceField field;
+        field.build(floor);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (level.walls.at(x, y) != field.at(x, y)) fail("wall distance", x, y);
+            }
+        }
+
+        OccupancyPyramid occupancy;
+        occupancy.build(floor);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (level.occupancy.isWall(x, y) != tiles.isWall(x, y)) fail("occupancy tile", x, y);
+            }
+        }
+        for (int i = 0; i < 256; i++) {
+            int x0 = rng.range(-2, width + 1);
+            int y0 = rng.range(-2, height + 1);
+            int x1 = x0 + rng.range(0, rng.chance(0.2f) ? 64 : 6);
+            int y1 = y0 + rng.range(0, rng.chance(0.2f) ? 64 : 6);
+            bool any = false;
+            bool all = true;
+            for (int y = y0; y <= y1; y++) {
+                for (int x = x0; x <= x1; x++) {
+                    bool wall = tiles.isWall(x, y);
+                    any = any || wall;
+                    all = all && wall;
+                }
+            }
+            if (level.occupancy.anyWall(x0, y0, x1, y1) != any) fail("occupancy anyWall", x0, y0);
+            if (level.occupancy.allWall(x0, y0, x1, y1) != all) fail("occupancy allWall", x0, y0);
+
+            sf::Vector2f from(rng.range(0.f, static_cast<float>(width)), rng.range(0.f, static_cast<float>(height)));
+            sf::Vector2f to = from + sf::Vector2f(rng.range(-12.f, 12.f), rng.range(-12.f, 12.f));
+            if (level.occupancy.segmentClear(from, to) != occupancy.segmentClear(from, to)) {
+                fail("occupancy segment", static_cast<int>(from.x), static_cast<int>(from.y));
+            }
+        }
+
+        // Boxes inside the map that cover each wall tile exactly once
+        std::vector<WallMesh::Rect> rects;
+        level.wallMesh.query({ 0, 0, width - 1, height - 1 }, rects);
+        std::vector<std::uint8_t> cover(static_cast<size_t>(width) * height, 0);
+        for (const WallMesh::Rect& rect : rects) {
+            if (rect.width <= 0 || rect.height <= 0 || rect.x < 0 || rect.y < 0
+                || rect.x + rect.width > width || rect.y + rect.height > height) {
+                fail("wall box out of bounds", rect.x, rect.y);
+                continue;
+            }
+            for (int y = rect.y; y < rect.y + rect.height; y++) {
+                for (int x = rect.x; x < rect.x + rect.width; x++) {
+                    cover[static_cast<size_t>(y) * width + x]++;
+                }
+            }
+        }
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (cover[static_cast<size_t>(y) * width + x] != (tiles.isWall(x, y) ? 1 : 0)) fail("wall boxes", x, y);
+            }
+        }
+        return errors;
+    }
+
+    // Makes random setTile / carveRect edits with the level's caches
+    // subscribed, comparing them with full rebuilds every few edits, and
+    // checks that takeDirty reports every tile that changed
+    int checkEdits(Level& level, int edits, std::string& error) {
+        static const int editsPerCompare = 25;
+
+        TileMap& tiles = level.maze;
+        tiles.addListener(&level.regions);
+        tiles.addListener(&level.walls);
+        tiles.addListener(&level.occupancy);
+        tiles.addListener(&level.wallMesh);
+        tiles.takeDirty();
+
+        const int width = tiles.getWidth();
+        const int height = tiles.getHeight();
+        std::vector<std::uint8_t> before(static_cast<size_t>(width) * height);
+        auto snapshot = [&]() {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    before[static_cast<size_t>(y) * width + x] = tiles.get(x, y);
+                }
+            }
+        };
+        snapshot();
+
+        Rng rng = Rng::forLevel(level.seed, level.number).split(static_cast<std::uint64_t>(edits));
+        int errors = 0;
+        sf::Vector2i centre;
+        for (int edit = 1; edit <= edits; edit++) {
+            // Each batch stays around one spot, edges included, so edits
+            // meet and split and rejoin regions
+            if (edit % editsPerCompare == 1) {
+                centre = sf::Vector2i(rng.range(0, width - 1), rng.range(0, height - 1));
+            }
+            int x = centre.x + rng.range(-8, 8);
+            int y = centre.y + rng.range(-8, 8);
+            if (rng.chance(0.15f)) {
+                tiles.carveRect(x, y, rng.range(1, 9), rng.range(1, 9));
+            }
+            else {
+                tiles.setTile(x, y, tiles.isWall(x, y) ? 0 : 1);
+            }
+            if (edit % editsPerCompare != 0 && edit != edits) continue;
+
+            std::vector<TileMap::TileRect> dirty = tiles.takeDirty();
+            for (int ty = 0; ty < height; ty++) {
+                for (int tx = 0; tx < width; tx++) {
+                    if (before[static_cast<size_t>(ty) * width + tx] == tiles.get(tx, ty)) continue;
+                    bool reported = std::any_of(dirty.begin(), dirty.end(), [&](const TileMap::TileRect& area) {
+                        return tx >= area.x0 && tx <= area.x1 && ty >= area.y0 && ty <= area.y1;
+                    });
+                    if (!reported && errors++ == 0) {
+                        error = "dirty areas miss " + std::to_string(tx) + "," + std::to_string(ty);
+                    }
+                }
+            }
+            snapshot();
+            std::string cacheError;
+            int cacheErrors = compareCaches(level, rng, cacheError);
+            if (cacheErrors > 0 && errors == 0) error = cacheError + " after " + std::to_string(edit) + " edits";
+            errors += cacheErrors;
+        }
+
+        tiles.removeListener(&level.regions);
+        tiles.removeListener(&level.walls);
+        tiles.removeListener(&level.occupancy);
+        tiles.removeListener(&level.wallMesh);
+        return errors;
+    }
+
+    Result measure(LevelGenerator& generator, std::uint64_t seed, int levelNumber, const std::string& dumpDir,
+        int editChecks) {
+        std::unique_ptr<Level> level = generator.generate(levelNumber, seed);
+
+        Result result;
+        result.seed = seed;
+        result.level = levelNumber;
+        result.size = level->maze.getWidth();
+        result.timings = level->timings;
+        result.repairs = level->repairs;
+        result.regions = level->regions.regionCount();
+        // Flooded from the start rather than asked of the level's RegionMap,
+        // so a labelling bug cannot hide a disconnected exit
+        sf::Vector2i start = toTile(level->playerStart);
+        sf::Vector2i exit = toTile(level->exitPosition);
+        result.connected = level->maze.walkable().floodFill(start.x, start.y).get(exit.x, exit.y);
+        result.pathLength = exitDistance(*level);
+        result.wallTiles = result.size * result.size - level->maze.walkable().count();
+        result.wallRects = level->wallMesh.rectCount();
+        result.tileBytes = level->maze.memoryUsage();
+        result.regionBytes = level->regions.memoryUsage();
+        result.fieldBytes = level->walls.memoryUsage();
+        result.pyramidBytes = level->occupancy.memoryUsage();
+        result.meshBytes = level->wallMesh.memoryUsage();
+        result.generatorBytes = level->generatorBytes;
+        if (!dumpDir.empty()) {
+            result.dumped = LevelFile::write(LevelFile::packPath(dumpDir, seed, levelNumber), *level);
+        }
+        if (editChecks > 0) {
+            result.cacheErrors = checkEdits(*level, editChecks, result.cacheError);
+        }
+        return result;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Range seeds;
+    Range levels{ 1, 10 };
+    int threadCount = std::max(1u, std::thread::hardware_concurrency());
+    int chunkWorkers = -1;
+    std::string dumpDir;
+    std::string traceFile;
+    int editChecks = 0;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--seeds" && hasValue) {
+            if (!parseRange(argv[++i], seeds)) {
+                std::cerr << "bad seed range\n";
+                return 2;
+            }
+        }
+        else if (arg == "--levels" && hasValue) {
+            if (!parseRange(argv[++i], levels) || levels.first < 1) {
+                std::cerr << "bad level range\n";
+                return 2;
+            }
+        }
+        else if (arg == "--threads" && hasValue) {
+            threadCount = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (arg == "--chunk-workers" && hasValue) {
+            chunkWorkers = std::max(0, std::atoi(argv[++i]));
+        }
+        else if (arg == "--dump" && hasValue) {
+            dumpDir = argv[++i];
+        }
+        else if (arg == "--trace" && hasValue) {
+            traceFile = argv[++i];
+        }
+        else if (arg == "--check-edits" && hasValue) {
+            editChecks = std::max(0, std::atoi(argv[++i]));
+        }
+        else {
+            std::cerr << "usage: mazegen [--seeds A[-B]] [--levels A[-B]] [--threads N] [--chunk-workers N] [--dump DIR]"
+                " [--trace FILE] [--check-edits N]\n";
+            return 2;
+        }
+    }
+
+    if (!dumpDir.empty()) {
+        std::filesystem::create_directories(dumpDir);
+    }
+
+    // Seed-major job list; results keep that order whatever thread ran them
+    std::vector<std::pair<std::uint64_t, int>> jobs;
+    for (std::uint64_t seed = seeds.first; seed <= seeds.last; seed++) {
+        for (std::uint64_t level = levels.first; level <= levels.last; level++) {
+            jobs.emplace_back(seed, static_cast<int>(level));
+        }
+        if (seed == seeds.last) break; // last may be UINT64_MAX
+    }
+
+    Profiler::setThreadName("main");
+    Profiler::setEnabled(!traceFile.empty());
+    JobSystem chunkJobs(chunkWorkers);
+    std::vector<Result> results(jobs.size());
+    std::atomic<size_t> nextJob{ 0 };
+    sf::Clock wallClock;
+
+    std::vector<std::thread> workers;
+    threadCount = static_cast<int>(std::min<size_t>(threadCount, std::max<size_t>(1, jobs.size())));
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            Profiler::setThreadName("level worker " + std::to_string(t));
+            LevelGenerator generator(&chunkJobs);
+            for (size_t job = nextJob++; job < jobs.size(); job = nextJob++) {
+                results[job] = measure(generator, jobs[job].first, jobs[job].second, dumpDir, editChecks);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    float wallSeconds = wallClock.getElapsedTime().asSeconds();
+
+    // The whole run is one frame of the trace
+    if (!traceFile.empty()) {
+        Profiler::endFrame();
+        if (!Profiler::writeChromeTrace(traceFile, 1)) {
+            std::cerr << "cannot write " << traceFile << "\n";
+        }
+    }
+
+    std::cout << "seed,level,size,rooms_ms,connect_ms,open_areas_ms,features_ms,chunks_ms,stitch_ms,repair_ms,"
+        "placement_ms,walls_ms,total_ms,"
+        "repairs,regions,connected,path_length,wall_tiles,wall_rects,"
+        "tiles_kib,regions_kib,walls_kib,occupancy_kib,mesh_kib,level_kib,generator_kib\n";
+
+    Level::StageTimes sum;
+    double tiles = 0.0;
+    int failures = 0;
+    int dumpFailures = 0;
+    int cacheFailures = 0;
+    double wallTiles = 0.0;
+    double wallRects = 0.0;
+    const Result* largest = nullptr;
+    for (const Result& result : results) {
+        const Level::StageTimes& t = result.timings;
+        std::cout << result.seed << "," << result.level << "," << result.size << ","
+            << t.rooms << "," << t.connect << "," << t.openAreas << "," << t.features << ","
+            << t.chunks << "," << t.stitch << "," << t.repair << "," << t.placement << "," << t.walls << "," << t.total() << ","
+            << result.repairs << "," << result.regions << "," << (result.connected ? 1 : 0) << ","
+            << result.pathLength << "," << result.wallTiles << "," << result.wallRects << ","
+            << result.tileBytes / 1024 << "," << result.regionBytes / 1024 << "," << result.fieldBytes / 1024 << ","
+            << result.pyramidBytes / 1024 << "," << result.meshBytes / 1024 << ","
+            << result.levelBytes() / 1024 << "," << result.generatorBytes / 1024 << "\n";
+        if (!largest || result.size > largest->size) largest = &result;
+
+        sum.rooms += t.rooms;
+        sum.connect += t.connect;
+        sum.openAreas += t.openAreas;
+        sum.features += t.features;
+        sum.chunks += t.chunks;
+        sum.stitch += t.stitch;
+        sum.repair += t.repair;
+        sum.placement += t.placement;
+        sum.walls += t.walls;
+        tiles += static_cast<double>(result.size) * result.size;
+        wallTiles += result.wallTiles;
+        wallRects += result.wallRects;
+        if (!result.connected || result.pathLength < 0) failures++;
+        if (!dumpDir.empty() && !result.dumped) dumpFailures++;
+        if (result.cacheErrors > 0) {
+            cacheFailures++;
+            std::cerr << "seed " << result.seed << " level " << result.level << ": " << result.cacheErrors
+                << " cache mismatches, first " << result.cacheError << "\n";
+        }
+    }
+
+    size_t count = results.size();
+    std::cerr << count << " levels on " << threadCount << " threads (" << chunkJobs.getWorkerCount()
+        << " chunk workers) in " << wallSeconds << " s ("
+        << (wallSeconds > 0.f ? count / wallSeconds : 0.f) << " levels/s, "
+        << (wallSeconds > 0.f ? tiles / wallSeconds / 1e6 : 0.0) << " Mtiles/s)\n";
+    if (count > 0) {
+        std::cerr << "mean ms per level: rooms " << sum.rooms / count
+            << ", connect " << sum.connect / count
+            << ", open areas " << sum.openAreas / count
+            << ", features " << sum.features / count
+            << ", chunks " << sum.chunks / count
+            << ", stitch " << sum.stitch / count
+            << ", repair " << sum.repair / count
+            << ", placement " << sum.placement / count
+            << ", walls " << sum.walls / count
+            << ", total " << sum.total() / count << "\n";
+        std::cerr << "mean walls per level: " << wallTiles / count << " tiles in "
+            << wallRects / count << " boxes\n";
+        std::cerr << "largest level " << largest->level << " (" << largest->size << "x" << largest->size << "): "
+            << largest->levelBytes() / 1048576.0 << " MiB once built, plus "
+            << largest->generatorBytes / 1048576.0 << " MiB of generator grid and labels\n";
+    }
+    // Also counts chunk grids, solver and search scratch and every thread's levels in flight
+    if (size_t peak = peakResidentBytes()) {
+        std::cerr << "process peak memory: " << peak / 1048576.0 << " MiB\n";
+    }
+    std::cerr << failures << " disconnected\n";
+    if (editChecks > 0) {
+        std::cerr << cacheFailures << " levels with caches that disagree with a rebuild after "
+            << editChecks << " edits\n";
+    }
+    if (dumpFailures > 0) {
+        std::cerr << dumpFailures << " levels could not be written to " << dumpDir << "\n";
+    }
+
+    return failures > 0 || cacheFailures > 0 ? 1 : 0;
+}
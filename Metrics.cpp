@@ -0,0 +1,125 @@
+#include "Metrics.h"
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Zero-initialised before any constructor runs, so allocations made
+    // during static initialisation are counted safely
+    std::atomic<std::int64_t> values[Metrics::Count];
+
+    const char* const names[Metrics::Count] = {
+        "draw_calls",
+        "vertices",
+        "path_nodes",
+        "allocations",
+        "allocated_bytes",
+        "enemies",
+        "projectiles",
+        "particles",
+        "texture_bytes",
+        "sound_bytes"
+    };
+
+    struct History {
+        std::mutex mutex;
+        Metrics::Sample last{};
+        std::int64_t frames = 0;
+        bool recording = false;
+        std::vector<Metrics::Sample> samples;
+    };
+
+    History& history() {
+        static History instance;
+        return instance;
+    }
+}
+
+const char* Metrics::name(Id id) {
+    return names[id];
+}
+
+void Metrics::add(Id id, std::int64_t amount) {
+    values[id].fetch_add(amount, std::memory_order_relaxed);
+}
+
+void Metrics::set(Id id, std::int64_t value) {
+    values[id].store(value, std::memory_order_relaxed);
+}
+
+void Metrics::countAllocation(std::size_t bytes) {
+    values[Allocations].fetch_add(1, std::memory_order_relaxed);
+    values[AllocatedBytes].fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+void Metrics::endFrame() {
+    Sample sample;
+    for (int i = 0; i < Count; i++) {
+        sample[i] = isCounter(static_cast<Id>(i)) ?
+            values[i].exchange(0, std::memory_order_relaxed) :
+            values[i].load(std::memory_order_relaxed);
+    }
+
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+    frames.last = sample;
+    frames.frames++;
+    if (frames.recording) frames.samples.push_back(sample);
+}
+
+Metrics::Sample Metrics::last() {
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+    return frames.last;
+}
+
+std::int64_t Metrics::frameNumber() {
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+    return frames.frames;
+}
+
+void Metrics::setRecording(bool recording) {
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+    frames.recording = recording;
+}
+
+bool Metrics::writeCsv(const std::string& path) {
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << "frame";
+    for (int i = 0; i < Count; i++) out << "," << names[i];
+    out << "\n";
+    for (size_t frame = 0; frame < frames.samples.size(); frame++) {
+        out << frame;
+        for (std::int64_t value : frames.samples[frame]) out << "," << value;
+        out << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+// Column-wise, one array per metric, which keeps the file small and loads
+// straight into a plot
+bool Metrics::writeJson(const std::string& path) {
+    History& frames = history();
+    std::lock_guard<std::mutex> lock(frames.mutex);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << "{\"frames\":" << frames.samples.size();
+    for (int i = 0; i < Count; i++) {
+        out << ",\n\"" << names[i] << "\":[";
+        for (size_t frame = 0; frame < frames.samples.size(); frame++) {
+            if (frame > 0) out << ",";
+            out << frames.samples[frame][i];
+        }
+        out << "]";
+    }
+    out << "\n}\n";
+    return static_cast<bool>(out);
+}
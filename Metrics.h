@@ -0,0 +1,46 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Numbers sampled once per frame for regression tracking. Counters add up
+// during a frame and start from zero in the next; gauges keep their value
+// until changed. Any thread may update them; endFrame() takes the sample.
+class Metrics {
+public:
+    enum Id {
+        // counters
+        DrawCalls,
+        Vertices,
+        PathNodes,      // A* nodes expanded
+        Allocations,    // heap allocations, counted by the operator new hook
+        AllocatedBytes,
+        // gauges
+        Enemies,
+        Projectiles,
+        Particles,
+        TextureBytes,
+        SoundBytes,
+        Count
+    };
+    using Sample = std::array<std::int64_t, Count>;
+
+    static const char* name(Id id);
+    static bool isCounter(Id id) { return id < Enemies; }
+
+    static void add(Id id, std::int64_t amount = 1);
+    static void set(Id id, std::int64_t value);
+    // Only touches atomics, so the allocation hook can call it at any time
+    static void countAllocation(std::size_t bytes);
+
+    static void endFrame();
+    static Sample last();
+    static std::int64_t frameNumber();
+
+    // Keeps every sample from now on for writeCsv/writeJson
+    static void setRecording(bool recording);
+    // One row per recorded frame
+    static bool writeCsv(const std::string& path);
+    static bool writeJson(const std::string& path);
+};
@@ -0,0 +1,6 @@
+#include "NullBackend.h"
+
+void NullBackend::present() {
+    presented++;
+    snapshot.reset();
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstdint>
+#include "RenderBackend.h"
+
+// Backend without a window: frames are recorded and dropped, no events
+// arrive. Nothing here touches OpenGL, so it works without a display.
+class NullBackend : public RenderBackend {
+public:
+    NullBackend(unsigned int width, unsigned int height) : size(width, height) {}
+
+    bool isOpen() const override { return open; }
+    void close() override { open = false; }
+    bool pollEvent(sf::Event&) override { return false; }
+    sf::Vector2u getSize() const override { return size; }
+
+    RenderSnapshot& frame() override { return snapshot; }
+    void present() override;
+
+    sf::RenderWindow* getWindow() override { return nullptr; }
+
+    std::uint64_t framesPresented() const { return presented; }
+
+private:
+    sf::Vector2u size;
+    bool open = true;
+    RenderSnapshot snapshot;
+    std::uint64_t presented = 0;
+};
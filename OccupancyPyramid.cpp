@@ -0,0 +1,264 @@
+#include "OccupancyPyramid.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // Gathers the even bits of a word into its low half
+    std::uint64_t packEvenBits(std::uint64_t x) {
+        x &= 0x5555555555555555ULL;
+        x = (x | (x >> 1)) & 0x3333333333333333ULL;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+        return x;
+    }
+
+    // Bits past the width are outside the map, which is solid
+    void fillPadding(std::vector<std::uint64_t>& words, int width, int height, int wordsPerRow) {
+        if (width % 64 == 0) return;
+        std::uint64_t outside = ~std::uint64_t(0) << (width % 64);
+        for (int y = 0; y < height; y++) {
+            words[static_cast<size_t>(y) * wordsPerRow + wordsPerRow - 1] |= outside;
+        }
+    }
+}
+
+void OccupancyPyramid::build(const Bitboard& floor) {
+    PROFILE_SCOPE("OccupancyPyramid::build");
+    levels.clear();
+
+    Level base;
+    base.width = floor.getWidth();
+    base.height = floor.getHeight();
+    base.wordsPerRow = floor.getWordsPerRow();
+    base.any.resize(static_cast<size_t>(base.wordsPerRow) * base.height);
+    for (int y = 0; y < base.height; y++) {
+        const std::uint64_t* row = floor.row(y);
+        for (int word = 0; word < base.wordsPerRow; word++) {
+            base.any[static_cast<size_t>(y) * base.wordsPerRow + word] = ~row[word];
+        }
+    }
+    fillPadding(base.any, base.width, base.height, base.wordsPerRow);
+    base.all = base.any;
+    levels.push_back(std::move(base));
+
+    // Each parent bit combines a 2x2 block: OR the two rows, then the two
+    // columns of every pair, then pack the pairs into half as many bits
+    while (levels.back().width > 1 || levels.back().height > 1) {
+        const Level& child = levels.back();
+        Level parent;
+        parent.width = (child.width + 1) / 2;
+        parent.height = (child.height + 1) / 2;
+        parent.wordsPerRow = (parent.width + 63) / 64;
+        parent.any.assign(static_cast<size_t>(parent.wordsPerRow) * parent.height, 0);
+        parent.all.assign(parent.any.size(), 0);
+
+        const std::uint64_t solid = ~std::uint64_t(0);
+        auto childWord = [&child, solid](const std::vector<std::uint64_t>& words, int y, int word) {
+            if (y >= child.height || word >= child.wordsPerRow) return solid;
+            return words[static_cast<size_t>(y) * child.wordsPerRow + word];
+        };
+
+        for (int y = 0; y < parent.height; y++) {
+            for (int word = 0; word < parent.wordsPerRow; word++) {
+                std::uint64_t anyBits = 0;
+                std::uint64_t allBits = 0;
+                for (int half = 0; half < 2; half++) {
+                    int source = word * 2 + half;
+                    std::uint64_t anyRows = childWord(child.any, 2 * y, source) | childWord(child.any, 2 * y + 1, source);
+                    std::uint64_t allRows = childWord(child.all, 2 * y, source) & childWord(child.all, 2 * y + 1, source);
+                    anyBits |= packEvenBits(anyRows | (anyRows >> 1)) << (32 * half);
+                    allBits |= packEvenBits(allRows & (allRows >> 1)) << (32 * half);
+                }
+                parent.any[static_cast<size_t>(y) * parent.wordsPerRow + word] = anyBits;
+                parent.all[static_cast<size_t>(y) * parent.wordsPerRow + word] = allBits;
+            }
+        }
+        fillPadding(parent.any, parent.width, parent.height, parent.wordsPerRow);
+        fillPadding(parent.all, parent.width, parent.height, parent.wordsPerRow);
+        levels.push_back(std::move(parent));
+    }
+}
+
+void OccupancyPyramid::onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) {
+    if (levels.empty() || tiles.getWidth() != getWidth() || tiles.getHeight() != getHeight()) {
+        build(tiles.walkable());
+        return;
+    }
+
+    int x0 = std::max(0, area.x0);
+    int y0 = std::max(0, area.y0);
+    int x1 = std::min(getWidth() - 1, area.x1);
+    int y1 = std::min(getHeight() - 1, area.y1);
+    if (x0 > x1 || y0 > y1) return;
+
+    Level& base = levels[0];
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            bool wall = tiles.isWall(x, y);
+            setBit(base.any, base, x, y, wall);
+            setBit(base.all, base, x, y, wall);
+        }
+    }
+
+    for (size_t depth = 1; depth < levels.size(); depth++) {
+        x0 >>= 1;
+        y0 >>= 1;
+        x1 >>= 1;
+        y1 >>= 1;
+        const Level& child = levels[depth - 1];
+        Level& level = levels[depth];
+        for (int cy = y0; cy <= y1; cy++) {
+            for (int cx = x0; cx <= x1; cx++) {
+                bool anyBit = false;
+                bool allBit = true;
+                for (int part = 0; part < 4; part++) {
+                    int childX = cx * 2 + (part & 1);
+                    int childY = cy * 2 + (part >> 1);
+                    bool outside = childX >= child.width || childY >= child.height;
+                    anyBit |= outside || bit(child.any, child, childX, childY);
+                    allBit &= outside || bit(child.all, child, childX, childY);
+                }
+                setBit(level.any, level, cx, cy, anyBit);
+                setBit(level.all, level, cx, cy, allBit);
+            }
+        }
+    }
+}
+
+bool OccupancyPyramid::bit(const std::vector<std::uint64_t>& words, const Level& level, int x, int y) {
+    return (words[static_cast<size_t>(y) * level.wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+}
+
+void OccupancyPyramid::setBit(std::vector<std::uint64_t>& words, const Level& level, int x, int y, bool value) {
+    std::uint64_t& word = words[static_cast<size_t>(y) * level.wordsPerRow + (x >> 6)];
+    std::uint64_t mask = std::uint64_t(1) << (x & 63);
+    word = value ? word | mask : word & ~mask;
+}
+
+size_t OccupancyPyramid::memoryUsage() const {
+    size_t bytes = levels.capacity() * sizeof(Level);
+    for (const Level& level : levels) {
+        bytes += (level.any.capacity() + level.all.capacity()) * sizeof(std::uint64_t);
+    }
+    return bytes;
+}
+
+bool OccupancyPyramid::isWall(int x, int y) const {
+    if (levels.empty() || x < 0 || y < 0 || x >= levels[0].width || y >= levels[0].height) return true;
+    return bit(levels[0].any, levels[0], x, y);
+}
+
+bool OccupancyPyramid::anyWall(int x0, int y0, int x1, int y1) const {
+    if (x0 > x1 || y0 > y1) return false;
+    if (levels.empty() || x0 < 0 || y0 < 0 || x1 >= getWidth() || y1 >= getHeight()) return true;
+    return anyIn(static_cast<int>(levels.size()) - 1, 0, 0, x0, y0, x1, y1);
+}
+
+bool OccupancyPyramid::allWall(int x0, int y0, int x1, int y1) const {
+    if (x0 > x1 || y0 > y1) return true;
+    if (levels.empty()) return true;
+    // Outside tiles are solid, so only the part inside the map matters
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, getWidth() - 1);
+    y1 = std::min(y1, getHeight() - 1);
+    if (x0 > x1 || y0 > y1) return true;
+    return allIn(static_cast<int>(levels.size()) - 1, 0, 0, x0, y0, x1, y1);
+}
+
+bool OccupancyPyramid::anyIn(int depth, int cx, int cy, int x0, int y0, int x1, int y1) const {
+    const Level& level = levels[depth];
+    if (cx >= level.width || cy >= level.height) return false; // beyond the map: not part of the query
+    int size = 1 << depth;
+    int bx0 = cx * size;
+    int by0 = cy * size;
+    int bx1 = bx0 + size - 1;
+    int by1 = by0 + size - 1;
+    if (bx1 < x0 || by1 < y0 || bx0 > x1 || by0 > y1) return false;
+
+    if (!bit(level.any, level, cx, cy)) return false;
+    if (bit(level.all, level, cx, cy)) return true;
+    // Mixed block wholly inside the query: it has a wall somewhere
+    if (bx0 >= x0 && by0 >= y0 && bx1 <= x1 && by1 <= y1) return true;
+
+    for (int child = 0; child < 4; child++) {
+        if (anyIn(depth - 1, cx * 2 + (child & 1), cy * 2 + (child >> 1), x0, y0, x1, y1)) return true;
+    }
+    return false;
+}
+
+bool OccupancyPyramid::allIn(int depth, int cx, int cy, int x0, int y0, int x1, int y1) const {
+    const Level& level = levels[depth];
+    if (cx >= level.width || cy >= level.height) return true;
+    int size = 1 << depth;
+    int bx0 = cx * size;
+    int by0 = cy * size;
+    int bx1 = bx0 + size - 1;
+    int by1 = by0 + size - 1;
+    if (bx1 < x0 || by1 < y0 || bx0 > x1 || by0 > y1) return true;
+
+    if (bit(level.all, level, cx, cy)) return true;
+    if (!bit(level.any, level, cx, cy)) return false;
+    if (bx0 >= x0 && by0 >= y0 && bx1 <= x1 && by1 <= y1) return false;
+
+    for (int child = 0; child < 4; child++) {
+        if (!allIn(depth - 1, cx * 2 + (child & 1), cy * 2 + (child >> 1), x0, y0, x1, y1)) return false;
+    }
+    return true;
+}
+
+// At each point, climb to the largest block that is still wall-free and
+// jump to where the segment leaves it
+bool OccupancyPyramid::segmentClear(sf::Vector2f from, sf::Vector2f to) const {
+    sf::Vector2f delta = to - from;
+    float length = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    // Nudge past block edges so the next step lands in the next block
+    float nudge = length > 0.f ? 1e-4f / length : 1.f;
+    auto blockOf = [&](float t, int depth) {
+        sf::Vector2f point = from + delta * std::min(t, 1.f);
+        return sf::Vector2i(static_cast<int>(std::floor(point.x)) >> depth, static_cast<int>(std::floor(point.y)) >> depth);
+    };
+
+    float t = 0.f;
+    while (true) {
+        sf::Vector2f point = from + delta * std::min(t, 1.f);
+        int x = static_cast<int>(std::floor(point.x));
+        int y = static_cast<int>(std::floor(point.y));
+        if (isWall(x, y)) return false;
+        if (t >= 1.f) return true;
+
+        int depth = 0;
+        while (depth + 1 < static_cast<int>(levels.size()) &&
+            !bit(levels[depth + 1].any, levels[depth + 1], x >> (depth + 1), y >> (depth + 1))) {
+            depth++;
+        }
+
+        // Exit of the empty block along the segment (slab test, far side only)
+        int size = 1 << depth;
+        float blockX = static_cast<float>((x >> depth) * size);
+        float blockY = static_cast<float>((y >> depth) * size);
+        float exitT = 1.f;
+        if (delta.x > 0.f) exitT = std::min(exitT, (blockX + size - from.x) / delta.x);
+        if (delta.x < 0.f) exitT = std::min(exitT, (blockX - from.x) / delta.x);
+        if (delta.y > 0.f) exitT = std::min(exitT, (blockY + size - from.y) / delta.y);
+        if (delta.y < 0.f) exitT = std::min(exitT, (blockY - from.y) / delta.y);
+
+        if (exitT >= 1.f) {
+            t = 1.f;
+            continue;
+        }
+
+        // On long segments the nudge can fall below the float step of t, so
+        // step by at least that and keep doubling until the block is left
+        float edge = std::max(exitT, t);
+        sf::Vector2i block(x >> depth, y >> depth);
+        float step = nudge;
+        do {
+            t = std::max(edge + step, std::nextafter(edge, 2.f));
+            step *= 2.f;
+        } while (t < 1.f && blockOf(t, depth) == block);
+    }
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "TileMap.h"
+
+// Mip pyramid of wall occupancy. Level 0 is one bit per tile; each level
+// above halves both sides and keeps two bits per block, "any wall" and "all
+// wall". Queries start at the single top block and only descend into mixed
+// blocks, so big empty rooms and solid rock are answered in one test.
+// Coordinates are tiles; everything outside the map counts as wall.
+class OccupancyPyramid : public TileMap::Listener {
+public:
+    void build(const Bitboard& floor);
+    // Rewrites the edited tiles and the blocks above them
+    void onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) override;
+
+    bool empty() const { return levels.empty(); }
+    int getWidth() const { return levels.empty() ? 0 : levels[0].width; }
+    int getHeight() const { return levels.empty() ? 0 : levels[0].height; }
+    // Heap bytes held, about two bits per tile over all levels
+    size_t memoryUsage() const;
+
+    bool isWall(int x, int y) const;
+    // Inclusive tile rectangles
+    bool anyWall(int x0, int y0, int x1, int y1) const;
+    bool allWall(int x0, int y0, int x1, int y1) const;
+    // True when the segment between two points (tile units) touches no wall
+    // tile. Steps through the largest empty block around each point.
+    bool segmentClear(sf::Vector2f from, sf::Vector2f to) const;
+
+private:
+    struct Level {
+        int width = 0;
+        int height = 0;
+        int wordsPerRow = 0;
+        std::vector<std::uint64_t> any;
+        std::vector<std::uint64_t> all;
+    };
+    std::vector<Level> levels;
+
+    static bool bit(const std::vector<std::uint64_t>& words, const Level& level, int x, int y);
+    static void setBit(std::vector<std::uint64_t>& words, const Level& level, int x, int y, bool value);
+    bool anyIn(int depth, int cx, int cy, int x0, int y0, int x1, int y1) const;
+    bool allIn(int depth, int cx, int cy, int x0, int y0, int x1, int y1) const;
+};
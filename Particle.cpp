@@ -28,8 +28,8 @@ void Particle::update(float deltaTime) {
 
 }
 
-void Particle::draw(sf::RenderWindow& window) {
-    window.draw(shape);
+void Particle::draw(RenderSnapshot& frame) {
+    frame.draw(shape);
 }
 
 bool Particle::isAlive() const {
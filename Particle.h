@@ -1,13 +1,14 @@
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "RenderSnapshot.h"
 
 class Particle {
 public:
     Particle(sf::Vector2f position, sf::Color color = sf::Color::White);
     ~Particle();
     void update(float deltaTime);
-    void draw(sf::RenderWindow& window);
+    void draw(RenderSnapshot& frame);
     bool isAlive() const;
 
 private:
@@ -0,0 +1,73 @@
+#include "Pathfinder.h"
+#include "Metrics.h"
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+bool Pathfinder::findPath(const TileMap& maze, sf::Vector2i start, sf::Vector2i target,
+    std::vector<sf::Vector2i>& path, const RegionMap* regions) {
+    path.clear();
+    if (maze.getWidth() == 0) return false;
+
+    auto heuristic = [](sf::Vector2i a, sf::Vector2i b) {
+        return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
+        };
+
+    // Unreachable target: skip the search instead of exhausting the region
+    if (regions && !regions->sameRegion(start, target)) return false;
+
+    // Side tables only hold visited tiles, so their size follows the search
+    // and not the level
+    int width = maze.getWidth();
+    auto key = [width](sf::Vector2i pos) { return pos.y * width + pos.x; };
+
+    std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
+    std::unordered_set<int> closedSet;
+    std::unordered_map<int, Node> nodeInfo;
+
+    Node startNode = { start, 0.f, heuristic(start, target), {-1, -1} };
+    openSet.push(startNode);
+    nodeInfo[key(start)] = startNode;
+
+    const int dx[4] = { 0, -1, 1, 0 };
+    const int dy[4] = { -1, 0, 0, 1 };
+
+    while (!openSet.empty()) {
+        Node current = openSet.top();
+        openSet.pop();
+
+        if (current.pos == target) {
+            Metrics::add(Metrics::PathNodes, static_cast<std::int64_t>(closedSet.size()));
+            sf::Vector2i pathNode = target;
+            while (pathNode != start) {
+                path.push_back(pathNode);
+                pathNode = nodeInfo[key(pathNode)].parent;
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+
+        // Stale queue entry for a tile already expanded
+        if (!closedSet.insert(key(current.pos)).second) continue;
+
+        for (int d = 0; d < 4; d++) {
+            sf::Vector2i neighbor(current.pos.x + dx[d], current.pos.y + dy[d]);
+            if (!maze.inBounds(neighbor.x, neighbor.y) || maze.isWall(neighbor.x, neighbor.y)) continue;
+
+            float moveCost = current.cost + 1.0f;
+            auto known = nodeInfo.find(key(neighbor));
+            if (!closedSet.count(key(neighbor)) &&
+                (known == nodeInfo.end() || moveCost < known->second.cost)) {
+
+                Node neighborNode = { neighbor, moveCost, heuristic(neighbor, target), current.pos };
+                nodeInfo[key(neighbor)] = neighborNode;
+                openSet.push(neighborNode);
+            }
+        }
+    }
+    Metrics::add(Metrics::PathNodes, static_cast<std::int64_t>(closedSet.size()));
+    return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "RegionMap.h"
+#include "TileMap.h"
+
+// A* over walkable tiles, cardinal moves only. Shared by the enemies that
+// chase the player and the bot that drives it.
+class Pathfinder {
+public:
+    // Fills path with the tiles after start up to and including target.
+    // Returns false and leaves path empty when target cannot be reached;
+    // with a region map that is known without searching.
+    static bool findPath(const TileMap& maze, sf::Vector2i start, sf::Vector2i target,
+        std::vector<sf::Vector2i>& path, const RegionMap* regions = nullptr);
+
+private:
+    struct Node {
+        sf::Vector2i pos;
+        float cost;
+        float heuristic;
+        sf::Vector2i parent;
+
+        bool operator>(const Node& other) const {
+            return (cost + heuristic) > (other.cost + other.heuristic);
+        }
+    };
+};
@@ -0,0 +1,111 @@
+#include "PlacementField.h"
+#include <algorithm>
+#include <cmath>
+
+PlacementField::Disks::Disks(float spacing, int width, int height)
+    : spacing(spacing),
+      reach(static_cast<int>(std::ceil(spacing / cellSize))),
+      cellColumns(width / cellSize + 1),
+      cellRows(height / cellSize + 1),
+      cells(static_cast<size_t>(width / cellSize + 1) * (height / cellSize + 1)) {
+}
+
+float PlacementField::Disks::clearance(sf::Vector2i tile) const {
+    float closest = spacing;
+    int cellX = tile.x / cellSize;
+    int cellY = tile.y / cellSize;
+
+    for (int cy = std::max(0, cellY - reach); cy <= std::min(cellRows - 1, cellY + reach); cy++) {
+        for (int cx = std::max(0, cellX - reach); cx <= std::min(cellColumns - 1, cellX + reach); cx++) {
+            for (int index : cells[static_cast<size_t>(cy) * cellColumns + cx]) {
+                float dx = static_cast<float>(tiles[index].x - tile.x);
+                float dy = static_cast<float>(tiles[index].y - tile.y);
+                closest = std::min(closest, std::sqrt(dx * dx + dy * dy));
+            }
+        }
+    }
+    return closest;
+}
+
+void PlacementField::Disks::add(sf::Vector2i tile) {
+    size_t cell = static_cast<size_t>(tile.y / cellSize) * cellColumns + tile.x / cellSize;
+    cells[cell].push_back(static_cast<int>(tiles.size()));
+    tiles.push_back(tile);
+}
+
+// Breadth-first search; visiting order is already sorted by distance
+void PlacementField::build(const Bitboard& floor, sf::Vector2i start) {
+    width = floor.getWidth();
+    height = floor.getHeight();
+    this->start = start;
+    distances.assign(static_cast<size_t>(width) * height, -1);
+    order.clear();
+    if (start.x < 0 || start.y < 0 || start.x >= width || start.y >= height) return;
+    if (!floor.get(start.x, start.y)) return;
+
+    int first = start.y * width + start.x;
+    distances[first] = 0;
+    order.push_back(first);
+
+    const int dx[4] = { 1, -1, 0, 0 };
+    const int dy[4] = { 0, 0, 1, -1 };
+
+    for (size_t head = 0; head < order.size(); head++) {
+        int current = order[head];
+        int cx = current % width;
+        int cy = current / width;
+
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + dx[d];
+            int ny = cy + dy[d];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+
+            int next = ny * width + nx;
+            if (distances[next] >= 0 || !floor.get(nx, ny)) continue;
+            distances[next] = distances[current] + 1;
+            order.push_back(next);
+        }
+    }
+}
+
+int PlacementField::maxDistance() const {
+    return order.empty() ? -1 : distances[order.back()];
+}
+
+int PlacementField::distance(sf::Vector2i tile) const {
+    if (tile.x < 0 || tile.y < 0 || tile.x >= width || tile.y >= height) return -1;
+    return distances[static_cast<size_t>(tile.y) * width + tile.x];
+}
+
+//index in order of the first tile at least minDistance away
+int PlacementField::firstAtLeast(int minDistance) const {
+    minDistance = std::min(minDistance, maxDistance());
+    auto found = std::lower_bound(order.begin(), order.end(), minDistance, [this](int index, int target) {
+        return distances[index] < target;
+    });
+    return static_cast<int>(found - order.begin());
+}
+
+sf::Vector2i PlacementField::pick(Rng& rng, int minDistance) const {
+    if (order.empty()) return start;
+
+    int index = order[rng.range(firstAtLeast(minDistance), reachableCount() - 1)];
+    return sf::Vector2i(index % width, index / width);
+}
+
+sf::Vector2i PlacementField::sample(Rng& rng, int minDistance, Disks& disks) const {
+    sf::Vector2i best = pick(rng, minDistance);
+    float bestClearance = disks.clearance(best);
+
+    for (int attempt = 1; attempt < sampleAttempts && bestClearance < disks.getSpacing(); attempt++) {
+        sf::Vector2i candidate = pick(rng, minDistance);
+        float candidateClearance = disks.clearance(candidate);
+        if (candidateClearance > bestClearance) {
+            best = candidate;
+            bestClearance = candidateClearance;
+        }
+    }
+
+    disks.add(best);
+    return best;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+#include "Bitboard.h"
+#include "Rng.h"
+
+// Walkable tiles reachable from a start tile, ordered by path distance from
+// it (one BFS). Uniform picks above a distance are a single random index, so
+// placement never loops waiting for a lucky roll.
+class PlacementField {
+public:
+    // Tiles already placed by one Poisson-disk pass, bucketed so a spacing
+    // check only looks at nearby cells
+    class Disks {
+    public:
+        // Tiles added must lie inside a width x height map
+        Disks(float spacing, int width, int height);
+
+        float getSpacing() const { return spacing; }
+        // Distance to the closest placed tile, capped at the spacing
+        float clearance(sf::Vector2i tile) const;
+        void add(sf::Vector2i tile);
+
+    private:
+        static const int cellSize = 8;
+        float spacing;
+        int reach; // cells to search around a tile
+        int cellColumns;
+        int cellRows;
+        std::vector<std::vector<int>> cells;
+        std::vector<sf::Vector2i> tiles;
+    };
+
+    void build(const Bitboard& floor, sf::Vector2i start);
+
+    int reachableCount() const { return static_cast<int>(order.size()); }
+    // Heap bytes held; distances are one int per tile
+    size_t memoryUsage() const { return (distances.capacity() + order.capacity()) * sizeof(int); }
+    int maxDistance() const;
+    // Steps from the start along walkable tiles, -1 when unreachable
+    int distance(sf::Vector2i tile) const;
+
+    // Uniform reachable tile at least minDistance steps away; the farthest
+    // band of tiles when nothing is that far
+    sf::Vector2i pick(Rng& rng, int minDistance = 0) const;
+
+    // Best-candidate Poisson-disk sampling: returns the first of a bounded
+    // number of picks that clears the spacing, otherwise the roomiest one.
+    // The result is added to disks.
+    sf::Vector2i sample(Rng& rng, int minDistance, Disks& disks) const;
+
+private:
+    static const int sampleAttempts = 30;
+
+    int width = 0;
+    int height = 0;
+    sf::Vector2i start;
+    std::vector<int> distances;
+    std::vector<int> order; // reachable tile indices, nondecreasing distance
+
+    int firstAtLeast(int minDistance) const;
+};
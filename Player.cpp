@@ -1,4 +1,6 @@
 ﻿#include "Player.h"
+#include "Log.h"
+#include "Profiler.h"
 #include "Particle.h"
 #include <vector>
 
@@ -6,8 +8,8 @@
 Player::Player() {
     loadTextures();
 
-    sprite.setTexture(idleTextures[0]);
-    textureSize = idleTextures[0].getSize();
+    TextureCache::apply(sprite, idleTextures[0]);
+    textureSize = idleTextures[0] ? idleTextures[0]->getSize() : sf::Vector2u();
     sprite.setOrigin(textureSize.x / 2.f, textureSize.y / 2.f);
 
     shape.setRadius(20.f);
@@ -24,10 +26,10 @@ Player::Player() {
     //audio
         // Load sound buffers
     if (!boltSoundBuffer.loadFromFile("assets/bolt.wav")) {
-        std::cerr << "Failed to load bolt sound!\n";
+        LOG_ERROR(Log::Assets, "Failed to load bolt sound!");
     }
     if (!fireballSoundBuffer.loadFromFile("assets/fireball.wav")) {
-        std::cerr << "Failed to load fireball sound!\n";
+        LOG_ERROR(Log::Assets, "Failed to load fireball sound!");
     }
 
     // Set up sounds
@@ -124,27 +126,21 @@ void Player::setPosition(float x, float y) {
 void Player::loadTextures()
 {
     for (int i = 0; i < 4; ++i) {
-        sf::Texture texture;
-        texture.loadFromFile("assets/idle_" + std::to_string(i) + ".png");
-        idleTextures.push_back(texture);
+        idleTextures.push_back(TextureCache::get("assets/idle_" + std::to_string(i) + ".png"));
         textures["idle_" + std::to_string(i)] = idleTextures.back();
     }
 
     for (int i = 0; i < 4; ++i) {
-        sf::Texture texture;
-        texture.loadFromFile("assets/walk_" + std::to_string(i) + ".png");
-        walkTextures.push_back(texture);
+        walkTextures.push_back(TextureCache::get("assets/walk_" + std::to_string(i) + ".png"));
         textures["walk_" + std::to_string(i)] = walkTextures.back();
     }
 
     for (int i = 0; i < 4; ++i) {
-        sf::Texture texture;
-        texture.loadFromFile("assets/attack_" + std::to_string(i) + ".png");
-        attackTextures.push_back(texture);
+        attackTextures.push_back(TextureCache::get("assets/attack_" + std::to_string(i) + ".png"));
         textures["attack_" + std::to_string(i)] = attackTextures.back();
     }
 
-    sprite.setTexture(idleTextures[0]);
+    TextureCache::apply(sprite, idleTextures[0]);
 
     // Set the origin of the sprite to the center of the texture
     sprite.setOrigin(sprite.getLocalBounds().width / 2, sprite.getLocalBounds().height / 2);
@@ -168,7 +164,7 @@ void Player::updateAnimation(float deltaTime) {
 
             std::string textureName = "attack_" + std::to_string(currentFrame);
             if (textures.count(textureName)) {
-                sprite.setTexture(textures[textureName]);
+                TextureCache::apply(sprite, textures[textureName]);
                 sprite.setOrigin(sprite.getLocalBounds().width / 2.f, sprite.getLocalBounds().height / 2.f);
                 // Flip based on facing direction
                 sprite.setScale(facingRight ? 1.f : -1.f, 1.f);
@@ -187,7 +183,7 @@ void Player::updateAnimation(float deltaTime) {
 
         std::string textureName = animationType + "_" + std::to_string(currentFrame);
         if (textures.count(textureName)) {
-            sprite.setTexture(textures[textureName]);
+            TextureCache::apply(sprite, textures[textureName]);
             sprite.setOrigin(sprite.getLocalBounds().width / 2.f, sprite.getLocalBounds().height / 2.f);
             // Flip based on facing direction
             sprite.setScale(facingRight ? 1.f : -1.f, 1.f);
@@ -197,15 +193,16 @@ void Player::updateAnimation(float deltaTime) {
 
 
 //main update function
-void Player::update(float deltaTime, sf::RenderWindow& window) {
+void Player::update(float deltaTime, const PlayerInput& input) {
+    PROFILE_SCOPE("Player::update");
     //  Handle Movement Input
-    handleMovementInput();
+    handleMovementInput(input);
 
     //  Apply Movement Modifiers (Sprint/Dash)
-    float currentSpeed = applyMovementModifiers(deltaTime);
+    float currentSpeed = applyMovementModifiers(deltaTime, input);
 
     // Process Attacks
-    handleAttacks(deltaTime, window);
+    handleAttacks(deltaTime, input);
 
     // Apply Physics
     shape.move(velocity * currentSpeed * deltaTime);
@@ -270,7 +267,7 @@ void Player::update(float deltaTime, sf::RenderWindow& window) {
         if (chargeParticleTimer > 0.05f) {
             chargeParticleTimer = 0.f;
             sf::CircleShape particle(3.f);
-            particle.setFillColor(sf::Color(255, 150 + rand() % 100, 0, 200));
+            particle.setFillColor(sf::Color(255, 150 + effectRng.range(0, 99), 0, 200));
             particle.setOrigin(3.f, 3.f);
             particle.setPosition(shape.getPosition());
             chargeParticles.push_back(particle);
@@ -293,28 +290,28 @@ void Player::update(float deltaTime, sf::RenderWindow& window) {
 // --- Helper Functions  ---
 
 
-void Player::handleMovementInput() {
+void Player::handleMovementInput(const PlayerInput& input) {
     velocity = { 0, 0 };
     isWalking = false;
 
     // Horizontal movement
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) {
+    if (input.left) {
         velocity.x = -1.f;
         facingRight = false;
         isWalking = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) {
+    if (input.right) {
         velocity.x = 1.f;
         facingRight = true;
         isWalking = true;
     }
 
     // Vertical movement
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) {
+    if (input.up) {
         velocity.y = -1.f;
         isWalking = true;
     }
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) {
+    if (input.down) {
         velocity.y = 1.f;
         isWalking = true;
     }
@@ -325,11 +322,11 @@ void Player::handleMovementInput() {
     }
 }
 
-float Player::applyMovementModifiers(float deltaTime) {
+float Player::applyMovementModifiers(float deltaTime, const PlayerInput& input) {
     float currentSpeed = speed;
 
     // Sprinting
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) &&
+    if (input.sprint &&
         stamina > 0.f &&
         sprintCooldown <= 0.f) {
         currentSpeed *= 2.f;
@@ -349,7 +346,7 @@ float Player::applyMovementModifiers(float deltaTime) {
     }
 
     // Dash
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Space) && dashCooldown <= 0.f && !isDashing && stamina >= 30.f) {
+    if (input.dash && dashCooldown <= 0.f && !isDashing && stamina >= 30.f) {
         if (velocity != sf::Vector2f(0, 0)) {
             stamina -= 30.f;
             dashCooldown = 0.5f;
@@ -362,18 +359,15 @@ float Player::applyMovementModifiers(float deltaTime) {
     return currentSpeed;
 }
 
-void Player::handleAttacks(float deltaTime, sf::RenderWindow& window) {
-    // Get the current view from the window
-    const sf::View& currentView = window.getView();
-
-    // Convert mouse position to world coordinates using the current view
-    sf::Vector2f mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window), currentView);
+void Player::handleAttacks(float deltaTime, const PlayerInput& input) {
+    // Aim point in world coordinates
+    sf::Vector2f mousePos = input.aim;
     sf::Vector2f playerCenter = shape.getPosition();
     sf::Vector2f direction = mousePos - playerCenter;
 
     // Debug output
-    std::cout << "Player: (" << playerCenter.x << "," << playerCenter.y << ") ";
-    std::cout << "Mouse: (" << mousePos.x << "," << mousePos.y << ")\n";
+    LOG_TRACE(Log::Player, "Player: (" << playerCenter.x << "," << playerCenter.y << ") "
+        << "Mouse: (" << mousePos.x << "," << mousePos.y << ")");
 
     // Normalize direction vector with minimum length check
     float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
@@ -394,7 +388,7 @@ void Player::handleAttacks(float deltaTime, sf::RenderWindow& window) {
     }
 
     // Fireball charging system - improved version
-    if (sf::Mouse::isButtonPressed(sf::Mouse::Right)) {
+    if (input.charge) {
         if (!isChargingFireball && mana >= 20.f && fireballCooldown <= 0.f) {
             isChargingFireball = true;
             fireballChargeTime = 0.f;
@@ -452,7 +446,7 @@ void Player::handleAttacks(float deltaTime, sf::RenderWindow& window) {
             fireballSound.setPitch(0.8f + chargeRatio * 0.4f);  // Lower pitch for stronger shots
 
             sf::Vector2f spawnPos = playerCenter + direction * 30.f;
-            fireballs.emplace_back(spawnPos, direction, 400.f + chargeRatio * 300.f, damage);
+            fireballs.emplace_back(spawnPos, direction, 400.f + chargeRatio * 300.f, damage, Rng(effectRng.next()));
 
           
         }
@@ -465,7 +459,7 @@ void Player::handleAttacks(float deltaTime, sf::RenderWindow& window) {
     }
     // Basic attack
     if (attackCooldown <= 0.f &&
-        sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
+        input.attack) {
         attackCooldown = 0.3f;
         isAttacking = true;
         boltSound.play();
@@ -474,8 +468,8 @@ void Player::handleAttacks(float deltaTime, sf::RenderWindow& window) {
         basicBolts.emplace_back(spawnPos, direction, 700.f);
 
         // Debug output
-        std::cout << "Bolt created at (" << spawnPos.x << "," << spawnPos.y
-            << ") with direction (" << direction.x << "," << direction.y << ")\n";
+        LOG_DEBUG(Log::Player, "Bolt created at (" << spawnPos.x << "," << spawnPos.y
+            << ") with direction (" << direction.x << "," << direction.y << ")");
     }
 }
 
@@ -553,18 +547,18 @@ void Player::normalizeVector(sf::Vector2f& vec) {
 
 
 //draw functions
-void Player::draw(sf::RenderWindow& window) {
+void Player::draw(RenderSnapshot& frame, float alpha) {
     // Draw all particles first (background effects)
     for (auto& p : particles) {
-        p.draw(window);
+        p.draw(frame);
     }
 
     // Draw all projectiles
     for (auto& fireball : fireballs) {
-        fireball.draw(window);
+        fireball.draw(frame);
     }
     for (auto& bolt : basicBolts) {
-        bolt.draw(window);
+        bolt.draw(frame);
     }
 
     // Visual feedback for dash
@@ -576,42 +570,45 @@ void Player::draw(sf::RenderWindow& window) {
     }
 
 
-    // Draw the player sprite
-    window.draw(sprite);
+    // Draw the player sprite where it is between the last two steps
+    sf::Vector2f shift = getRenderPosition(alpha) - shape.getPosition();
+    sprite.move(shift);
+    frame.draw(sprite);
+    sprite.move(-shift);
 
   
 
 
     // Draw collision debug visualization (can be toggled)
     if (showCollisionDebug) {
-        window.draw(collisionDebug);
+        frame.draw(collisionDebug);
 
         // Optional: Draw direction indicator
         sf::Vertex line[] = {
             sf::Vertex(shape.getPosition(), sf::Color::Green),
             sf::Vertex(shape.getPosition() + sf::Vector2f(velocity.x * 20.f, velocity.y * 20.f), sf::Color::Red)
         };
-        window.draw(line, 2, sf::Lines);
+        frame.draw(line, 2, sf::Lines);
     }
 
     // Draw HUD elements
-    drawHUD(window);
+    drawHUD(frame);
 
     // Draw attack effects
     for (auto& attack : attacks) {
-        attack.draw(window);
+        attack.draw(frame);
 
     }
 
 
      // Draw charge particles
     for (const auto& particle : chargeParticles) {
-        window.draw(particle);
+        frame.draw(particle);
     }
 
     // Draw charge indicator if charging
     if (isChargingFireball) {
-        window.draw(chargeIndicator);
+        frame.draw(chargeIndicator);
         
         // Draw charge percentage text
         if (showCollisionDebug) {  // Or always show it
@@ -619,22 +616,22 @@ void Player::draw(sf::RenderWindow& window) {
             sf::Text chargeText;
             chargeText.setString(std::to_string(chargePercent) + "%");
             chargeText.setPosition(shape.getPosition().x - 20.f, shape.getPosition().y - 50.f);
-            window.draw(chargeText);
+            frame.draw(chargeText);
         }
     }
 
 }
 
-void Player::drawHUD(sf::RenderWindow& window) {
+void Player::drawHUD(RenderSnapshot& frame) {
     // Get view position for HUD anchoring
-    sf::Vector2f viewCenter = window.getView().getCenter();
-    sf::Vector2f viewSize = window.getView().getSize();
+    sf::Vector2f viewCenter = frame.getView().getCenter();
+    sf::Vector2f viewSize = frame.getView().getSize();
     float hudX = viewCenter.x - viewSize.x / 2 + 10.f;
     float hudY = viewCenter.y - viewSize.y / 2 + 30.f;
     float hpBarHeight = 150.0f;
 
     // Health Bar
-    drawBar(window, hudX, hudY, 12.0f, hpBarHeight,
+    drawBar(frame, hudX, hudY, 12.0f, hpBarHeight,
         health / maxHealth,
         sf::Color::Green, "Health");
 
@@ -642,18 +639,18 @@ void Player::drawHUD(sf::RenderWindow& window) {
     float staminaRatio = stamina / maxStamina;
     sf::Color staminaColor = (staminaRatio > 0.5f) ? sf::Color::Yellow :
         (staminaRatio > 0.2f) ? sf::Color(255, 165, 0) : sf::Color::Red;
-    drawBar(window, hudX + 20.f, hudY, 12.0f, hpBarHeight,
+    drawBar(frame, hudX + 20.f, hudY, 12.0f, hpBarHeight,
         staminaRatio, staminaColor, "Stamina");
 
     // Mana Bar (40px right of health)
     float manaRatio = mana / maxMana;
     sf::Color manaColor = (manaRatio > 0.5f) ? sf::Color::Blue :
         (manaRatio > 0.2f) ? sf::Color(100, 100, 255) : sf::Color(50, 50, 150);
-    drawBar(window, hudX + 40.f, hudY, 12.0f, hpBarHeight,
+    drawBar(frame, hudX + 40.f, hudY, 12.0f, hpBarHeight,
         manaRatio, manaColor, "Mana");
 }
 
-void Player::drawBar(sf::RenderWindow& window, float x, float y, float width, float height,
+void Player::drawBar(RenderSnapshot& frame, float x, float y, float width, float height,
     float ratio, const sf::Color& fillColor, const std::string& label) {
     // Background
     sf::RectangleShape background(sf::Vector2f(width, height));
@@ -661,13 +658,13 @@ void Player::drawBar(sf::RenderWindow& window, float x, float y, float width, fl
     background.setOutlineThickness(1.0f);
     background.setOutlineColor(sf::Color::Black);
     background.setPosition(x, y);
-    window.draw(background);
+    frame.draw(background);
 
     // Fill
     sf::RectangleShape bar(sf::Vector2f(width, height * ratio));
     bar.setFillColor(fillColor);
     bar.setPosition(x, y + (height * (1 - ratio)));
-    window.draw(bar);
+    frame.draw(bar);
 
   
     }
@@ -687,7 +684,7 @@ void Player::takeDamage(float damage)
     if (!canTakeDamage) return;
 
     health -= damage;
-    std::cout << "Player took " << damage << " damage. Health now: " << health << std::endl;
+    LOG_DEBUG(Log::Player, "Player took " << damage << " damage. Health now: " << health);
     if (health < 0.0f) health = 0.0f;
 
     canTakeDamage = false;
@@ -722,6 +719,10 @@ void Player::setEnemyList(std::vector<std::unique_ptr<Enemy>>* enemies) {
     enemyList = enemies;
 }
 
+sf::Vector2f Player::getRenderPosition(float alpha) const {
+    return previousPosition + (shape.getPosition() - previousPosition) * alpha;
+}
+
 sf::FloatRect Player::getBounds() const
 {
 	return collisionBox;
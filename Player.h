@@ -8,11 +8,28 @@
 #include <SFML/Audio.hpp>
 #include "Fireball.h"
 #include "BasicBolt.h"
+#include "Rng.h"
+#include "RenderSnapshot.h"
+#include "TextureCache.h"
 #include <memory>
 
 // Forward declaration of Enemy
 class Enemy;
 
+// Controls for one simulation step. Game fills it from the keyboard and
+// mouse, or leaves it idle when running headless.
+struct PlayerInput {
+    bool left = false;
+    bool right = false;
+    bool up = false;
+    bool down = false;
+    bool sprint = false;
+    bool dash = false;
+    bool attack = false; // basic bolt
+    bool charge = false; // charges a fireball, fires on release
+    sf::Vector2f aim;    // world position aimed at
+};
+
 struct AttackEffect {
     sf::ConvexShape shape;
     float timer;
@@ -34,8 +51,8 @@ struct AttackEffect {
         return timer <= 0.f;
     }
 
-    void draw(sf::RenderWindow& win) {
-        win.draw(shape);
+    void draw(RenderSnapshot& frame) {
+        frame.draw(shape);
     }
 };
 
@@ -45,8 +62,8 @@ public:
 	~Player();
     void loadTextures();
     void updateAnimation(float deltaTime);
-    void update(float deltaTime, sf::RenderWindow& window);
-    void draw(sf::RenderWindow& window);
+    void update(float deltaTime, const PlayerInput& input);
+    void draw(RenderSnapshot& frame, float alpha = 1.f);
     void setPosition(float x, float y);
     float getX() const;
     float getY() const;
@@ -62,6 +79,9 @@ public:
     // Enemy-related methods
     void setEnemyList(std::vector<std::unique_ptr<Enemy>>* enemies);
     sf::Vector2f getPosition() const { return shape.getPosition(); }
+    // Interpolation between simulation steps, see Enemy
+    void savePreviousPosition() { previousPosition = shape.getPosition(); }
+    sf::Vector2f getRenderPosition(float alpha) const;
     sf::FloatRect getBounds() const;
     sf::FloatRect getCollisionBox() const;
     void setPosition(const sf::Vector2f& position);
@@ -73,12 +93,22 @@ public:
 
     bool isAlive() const { return health > 0.0f; }
 
+    // For the metrics
+    std::size_t projectileCount() const { return fireballs.size() + basicBolts.size(); }
+    std::size_t particleCount() const { return particles.size() + chargeParticles.size(); }
+    std::size_t soundBytes() const {
+        return (boltSoundBuffer.getSampleCount() + fireballSoundBuffer.getSampleCount()) * sizeof(sf::Int16);
+    }
+
     //poweups
     void addMana(float amount);
     void applyDamageBoost(float multiplier, float duration);
     void applySpeedBoost(float multiplier, float duration);
     void applyFireRateBoost(float multiplier, float duration);
 
+    // Stream for cosmetic randomness (particles, fireball flicker)
+    void setRandomStream(const Rng& rng) { effectRng = rng; }
+
 private:
 
  //firebal
@@ -106,15 +136,15 @@ private:
 
     // Helper methods
     void updateParticles(float deltaTime);
-    void handleMovementInput();
-    float applyMovementModifiers(float deltaTime);
-    void handleAttacks(float deltaTime, sf::RenderWindow& window);
+    void handleMovementInput(const PlayerInput& input);
+    float applyMovementModifiers(float deltaTime, const PlayerInput& input);
+    void handleAttacks(float deltaTime, const PlayerInput& input);
     void updateCooldowns(float deltaTime);
     void updateProjectiles(float deltaTime);
     void handleEnemyCollisions();
     void normalizeVector(sf::Vector2f& vec);
-    void drawHUD(sf::RenderWindow& window);
-    void drawBar(sf::RenderWindow& window, float x, float y, float width,
+    void drawHUD(RenderSnapshot& frame);
+    void drawBar(RenderSnapshot& frame, float x, float y, float width,
         float height, float ratio, const sf::Color& fillColor,
         const std::string& label = "");
 
@@ -133,12 +163,12 @@ private:
 
     // Graphics
     sf::Vector2u textureSize;
-    sf::Texture texture;
     sf::Sprite sprite;
-    std::vector<sf::Texture> idleTextures;
-    std::vector<sf::Texture> walkTextures;
-    std::vector<sf::Texture> attackTextures;
-    std::map<std::string, sf::Texture> textures;
+    // Shared textures from TextureCache, null when headless
+    std::vector<const sf::Texture*> idleTextures;
+    std::vector<const sf::Texture*> walkTextures;
+    std::vector<const sf::Texture*> attackTextures;
+    std::map<std::string, const sf::Texture*> textures;
 
     // Animation
     float attackAnimationSpeed = 0.1f;
@@ -154,6 +184,7 @@ private:
     // Particles
     std::vector<Particle> particles;
     sf::Color defaultColor = sf::Color::Cyan;
+    Rng effectRng;
 
     // Stats
     float stamina;
@@ -168,6 +199,7 @@ private:
 
     // Movement
     sf::CircleShape shape;
+    sf::Vector2f previousPosition;
     sf::Vector2f velocity;
     float speed = 250.0f;
 
@@ -0,0 +1,245 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace {
+    // One per thread; shared so a frame can still collect events from a
+    // thread that has exited
+    struct ThreadLog {
+        std::mutex mutex;
+        std::vector<Profiler::Event> events;
+        std::vector<Profiler::Mark> marks;
+        std::uint32_t id = 0;
+        std::uint32_t depth = 0; // touched only by the owning thread
+    };
+
+    struct State {
+        std::atomic<bool> enabled{ false };
+        std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+        std::mutex mutex; // guards everything below
+        std::vector<std::shared_ptr<ThreadLog>> threads;
+        std::vector<std::string> names;
+        std::deque<Profiler::Frame> history;
+        size_t historySize = 300;
+        std::int64_t frameStart = 0;
+        std::int64_t lastFrameLength = 0;
+    };
+
+    State& state() {
+        static State instance;
+        return instance;
+    }
+
+    thread_local std::shared_ptr<ThreadLog> localLog;
+
+    ThreadLog& threadLog() {
+        if (!localLog) {
+            State& profiler = state();
+            auto log = std::make_shared<ThreadLog>();
+            std::lock_guard<std::mutex> lock(profiler.mutex);
+            log->id = static_cast<std::uint32_t>(profiler.threads.size());
+            profiler.threads.push_back(log);
+            profiler.names.push_back("thread " + std::to_string(log->id));
+            localLog = log;
+        }
+        return *localLog;
+    }
+
+    void writeEscaped(std::ofstream& out, const std::string& text) {
+        for (char c : text) {
+            if (c == '"' || c == '\\') out << '\\';
+            out << c;
+        }
+    }
+}
+
+void Profiler::setEnabled(bool enabled) {
+    state().enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    return state().enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadLog& log = threadLog();
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    profiler.names[log.id] = name;
+}
+
+std::int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - state().epoch).count();
+}
+
+std::int64_t Profiler::begin() {
+    threadLog().depth++;
+    return now();
+}
+
+void Profiler::end(const char* name, std::int64_t start) {
+    std::int64_t finish = now();
+    ThreadLog& log = threadLog();
+    log.depth--;
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.events.push_back({ name, start, finish, log.id, log.depth });
+}
+
+void Profiler::mark(const char* name, std::int64_t value) {
+    if (!isEnabled()) return;
+    std::int64_t time = now();
+    ThreadLog& log = threadLog();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    log.marks.push_back({ name, time, log.id, value });
+}
+
+void Profiler::setHistorySize(int frames) {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    profiler.historySize = static_cast<size_t>(std::max(frames, 1));
+    while (profiler.history.size() > profiler.historySize) {
+        profiler.history.pop_front();
+    }
+}
+
+void Profiler::endFrame() {
+    State& profiler = state();
+    std::int64_t finish = now();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+
+    Frame frame;
+    frame.start = profiler.frameStart;
+    frame.end = finish;
+    profiler.frameStart = finish;
+    profiler.lastFrameLength = finish - frame.start;
+    for (const auto& log : profiler.threads) {
+        std::lock_guard<std::mutex> logLock(log->mutex);
+        frame.events.insert(frame.events.end(), log->events.begin(), log->events.end());
+        frame.marks.insert(frame.marks.end(), log->marks.begin(), log->marks.end());
+        log->events.clear();
+        log->marks.clear();
+    }
+    if (!isEnabled() && frame.events.empty() && frame.marks.empty()) return;
+
+    profiler.history.push_back(std::move(frame));
+    if (profiler.history.size() > profiler.historySize) {
+        profiler.history.pop_front();
+    }
+}
+
+void Profiler::discardFrame() {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    profiler.frameStart = now();
+    for (const auto& log : profiler.threads) {
+        std::lock_guard<std::mutex> logLock(log->mutex);
+        log->events.clear();
+        log->marks.clear();
+    }
+}
+
+float Profiler::lastFrameTime() {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    return profiler.lastFrameLength / 1e6f;
+}
+
+std::vector<float> Profiler::frameTimes() {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    std::vector<float> times;
+    times.reserve(profiler.history.size());
+    for (const Frame& frame : profiler.history) {
+        times.push_back((frame.end - frame.start) / 1e6f);
+    }
+    return times;
+}
+
+bool Profiler::lastFrame(Frame& out) {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    if (profiler.history.empty()) return false;
+    out = profiler.history.back();
+    return true;
+}
+
+std::vector<std::string> Profiler::threadNames() {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+    return profiler.names;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path, int frameCount,
+    const std::vector<std::pair<std::string, std::string>>& info) {
+    State& profiler = state();
+    std::lock_guard<std::mutex> lock(profiler.mutex);
+
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) return false;
+    out << std::fixed;
+    out.precision(3);
+
+    // Complete ("X") events in microseconds, one lane per thread, plus a
+    // lane of frame boundaries
+    const std::uint32_t frameLane = static_cast<std::uint32_t>(profiler.names.size());
+    out << "{\"traceEvents\":[\n";
+    bool first = true;
+    auto separator = [&out, &first]() {
+        if (!first) out << ",\n";
+        first = false;
+    };
+    for (size_t id = 0; id < profiler.names.size(); id++) {
+        separator();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id << ",\"args\":{\"name\":\"";
+        writeEscaped(out, profiler.names[id]);
+        out << "\"}}";
+    }
+    separator();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << frameLane << ",\"args\":{\"name\":\"frames\"}}";
+
+    size_t kept = profiler.history.size();
+    size_t skip = frameCount >= 0 && kept > static_cast<size_t>(frameCount) ? kept - frameCount : 0;
+    for (size_t i = skip; i < profiler.history.size(); i++) {
+        const Frame& frame = profiler.history[i];
+        separator();
+        out << "{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":" << frameLane
+            << ",\"ts\":" << frame.start / 1000.0 << ",\"dur\":" << (frame.end - frame.start) / 1000.0 << "}";
+        for (const Event& event : frame.events) {
+            separator();
+            out << "{\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+        }
+        for (const Mark& mark : frame.marks) {
+            separator();
+            out << "{\"name\":\"";
+            writeEscaped(out, mark.name);
+            out << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << mark.thread
+                << ",\"ts\":" << mark.time / 1000.0 << ",\"args\":{\"value\":" << mark.value << "}}";
+        }
+    }
+    out << "\n]";
+
+    if (!info.empty()) {
+        out << ",\n\"otherData\":{";
+        for (size_t i = 0; i < info.size(); i++) {
+            if (i > 0) out << ",";
+            out << "\"";
+            writeEscaped(out, info[i].first);
+            out << "\":\"";
+            writeEscaped(out, info[i].second);
+            out << "\"";
+        }
+        out << "}";
+    }
+    out << "}\n";
+    return static_cast<bool>(out);
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Scoped timers for finding where a frame goes. PROFILE_SCOPE("name") times
+// the rest of the enclosing block; the name must be a string literal, only
+// the pointer is kept. Every thread appends to its own log, so work on job
+// system workers, the render thread and the prefetcher gets its own lane.
+//
+// Recording is off until setEnabled(true); a disabled timer is one relaxed
+// load. Built without MAZE_PROFILER the macros expand to nothing and only
+// frame times and mark() events remain.
+class Profiler {
+public:
+    struct Event {
+        const char* name;
+        std::int64_t start; // nanoseconds since the profiler started
+        std::int64_t end;
+        std::uint32_t thread;
+        std::uint32_t depth; // nesting on its thread, 0 = outermost
+    };
+
+    // A moment worth finding in a trace: a level change, a mass spawn
+    struct Mark {
+        const char* name;
+        std::int64_t time;
+        std::uint32_t thread;
+        std::int64_t value;
+    };
+
+    struct Frame {
+        std::int64_t start;
+        std::int64_t end;
+        std::vector<Event> events; // ordered by thread, then by end time
+        std::vector<Mark> marks;
+    };
+
+    // Frames kept, 300 unless changed
+    static void setHistorySize(int frames);
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+    // Lane name in traces; threads are numbered in order of first use
+    static void setThreadName(const std::string& name);
+    static std::int64_t now();
+
+    // Closes the current frame: everything finished on any thread since the
+    // last call belongs to it. Called once per frame by the main loop.
+    static void endFrame();
+    // Starts the next frame now and drops what was recorded since the last
+    // one, for time spent outside the loop (menus)
+    static void discardFrame();
+    // Length of the frame endFrame() closed last, in milliseconds
+    static float lastFrameTime();
+
+    // Records a named moment, with a number for context; name must be a
+    // string literal
+    static void mark(const char* name, std::int64_t value = 0);
+
+    // Durations of the kept frames in milliseconds, oldest first
+    static std::vector<float> frameTimes();
+    // Most recent complete frame; false when none was recorded
+    static bool lastFrame(Frame& out);
+    static std::vector<std::string> threadNames();
+    // Writes the last frameCount frames (all kept with -1) as Chrome trace
+    // JSON (about:tracing); info goes into its otherData block
+    static bool writeChromeTrace(const std::string& path, int frameCount = -1,
+        const std::vector<std::pair<std::string, std::string>>& info = {});
+
+    class Scope {
+    public:
+        explicit Scope(const char* name) : name(name), start(isEnabled() ? begin() : -1) {}
+        ~Scope() {
+            if (start >= 0) end(name, start);
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        std::int64_t start;
+    };
+
+private:
+    static std::int64_t begin();
+    static void end(const char* name, std::int64_t start);
+};
+
+#if defined(MAZE_PROFILER)
+#define PROFILE_JOIN_INNER(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN_INNER(a, b)
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILE_JOIN(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
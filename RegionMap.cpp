@@ -0,0 +1,277 @@
+#include "RegionMap.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+// Run-based scanline labelling: every run of floor tiles in a row is one
+// union-find node, united with the runs of the row above it overlaps
+void RegionMap::build(const Bitboard& floor) {
+    width = floor.getWidth();
+    height = floor.getHeight();
+    labels.assign(static_cast<size_t>(width) * height, -1);
+    parent.clear();
+    sizes.clear();
+    activeRegions = 0;
+
+    struct Run {
+        int y;
+        int x0;
+        int x1;
+        int label;
+    };
+    std::vector<Run> runs;
+    size_t previousStart = 0;
+    size_t previousEnd = 0;
+
+    for (int y = 0; y < height; y++) {
+        size_t rowStart = runs.size();
+        size_t above = previousStart;
+
+        floor.forEachRun(y, [&](int x0, int x1) {
+            // Runs above are sorted by x; skip those ending before this one
+            while (above < previousEnd && runs[above].x1 < x0) above++;
+
+            int label = -1;
+            for (size_t i = above; i < previousEnd && runs[i].x0 <= x1; i++) {
+                label = label < 0 ? compress(runs[i].label) : unite(label, runs[i].label);
+            }
+            if (label < 0) label = newLabel();
+
+            sizes[compress(label)] += x1 - x0 + 1;
+            runs.push_back({ y, x0, x1, label });
+        });
+
+        previousStart = rowStart;
+        previousEnd = runs.size();
+    }
+
+    // Flatten to compact ids (in scan order) so every query is a single lookup
+    std::vector<int> compact(parent.size(), -1);
+    std::vector<int> compactSizes;
+    for (const Run& run : runs) {
+        int root = compress(run.label);
+        if (compact[root] < 0) {
+            compact[root] = static_cast<int>(compactSizes.size());
+            compactSizes.push_back(sizes[root]);
+        }
+        auto rowStart = labels.begin() + static_cast<size_t>(run.y) * width;
+        std::fill(rowStart + run.x0, rowStart + run.x1 + 1, compact[root]);
+    }
+
+    sizes = std::move(compactSizes);
+    parent.resize(sizes.size());
+    for (size_t i = 0; i < parent.size(); i++) {
+        parent[i] = static_cast<int>(i);
+    }
+    activeRegions = static_cast<int>(sizes.size());
+}
+
+void RegionMap::build(const std::vector<std::vector<int>>& maze) {
+    build(Bitboard::fromGrid(maze));
+}
+
+void RegionMap::build(const TileMap& tiles) {
+    build(tiles.walkable());
+}
+
+// Keeps the labels valid after a single tile edit
+void RegionMap::updateTile(const std::vector<std::vector<int>>& maze, int x, int y) {
+    if (static_cast<int>(maze.size()) != height || height == 0 ||
+        static_cast<int>(maze[0].size()) != width) {
+        build(maze);
+        return;
+    }
+    if (applyTile(x, y, [&maze](int tx, int ty) { return maze[ty][tx] == 0; })) {
+        build(maze);
+        return;
+    }
+    flatten();
+}
+
+// Edits are applied tile by tile against the final map; the first tile that
+// might split a region relabels everything, which covers the rest too
+void RegionMap::onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) {
+    if (tiles.getWidth() != width || tiles.getHeight() != height) {
+        build(tiles);
+        return;
+    }
+    auto isFloor = [&tiles](int tx, int ty) { return !tiles.isWall(tx, ty); };
+    for (int y = std::max(0, area.y0); y <= std::min(height - 1, area.y1); y++) {
+        for (int x = std::max(0, area.x0); x <= std::min(width - 1, area.x1); x++) {
+            if (applyTile(x, y, isFloor)) {
+                build(tiles);
+                return;
+            }
+        }
+    }
+    flatten();
+}
+
+// Updates one tile in place; true when the caller has to relabel
+bool RegionMap::applyTile(int x, int y, const std::function<bool(int, int)>& isFloor) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return false;
+
+    size_t index = static_cast<size_t>(y) * width + x;
+    bool wasWalkable = labels[index] >= 0;
+    bool isWalkable = isFloor(x, y);
+    if (wasWalkable == isWalkable) return false;
+
+    const int dx[4] = { 0, 1, 0, -1 };
+    const int dy[4] = { -1, 0, 1, 0 };
+
+    if (isWalkable) {
+        // Carved: join every neighbouring region through this tile
+        int label = -1;
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[i];
+            int ny = y + dy[i];
+            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+            int neighbor = labels[static_cast<size_t>(ny) * width + nx];
+            if (neighbor < 0) continue;
+            label = label < 0 ? compress(neighbor) : unite(label, neighbor);
+        }
+        if (label < 0) label = newLabel();
+
+        labels[index] = label;
+        sizes[compress(label)]++;
+        return false;
+    }
+
+    // Walled: removal can only split the region if the floor tiles around it
+    // are not already connected through the surrounding ring. Walk the 8-ring
+    // (consecutive entries are 4-adjacent) and count floor runs that touch a
+    // cardinal neighbour.
+    const int ringX[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    const int ringY[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+    bool floor[8];
+    for (int i = 0; i < 8; i++) {
+        int nx = x + ringX[i];
+        int ny = y + ringY[i];
+        floor[i] = nx >= 0 && ny >= 0 && nx < width && ny < height && isFloor(nx, ny);
+    }
+
+    int runs = 0;
+    int start = 0;
+    while (start < 8 && floor[start]) start++;
+    if (start < 8) {
+        // Start on a wall so every run is closed before the walk ends
+        bool inRun = false;
+        bool touchesCardinal = false;
+        for (int step = 1; step <= 8; step++) {
+            int i = (start + step) % 8;
+            if (floor[i]) {
+                if (!inRun) {
+                    inRun = true;
+                    touchesCardinal = false;
+                }
+                if (i % 2 == 0) touchesCardinal = true;
+            }
+            else if (inRun) {
+                if (touchesCardinal) runs++;
+                inRun = false;
+            }
+        }
+    }
+
+    int root = compress(labels[index]);
+    labels[index] = -1;
+    if (runs > 1) return true;
+    sizes[root]--;
+    if (sizes[root] == 0) activeRegions--;
+    return false;
+}
+
+//looks up the region of a tile
+int RegionMap::regionOf(sf::Vector2i pos) const {
+    if (pos.x < 0 || pos.y < 0 || pos.x >= width || pos.y >= height) return -1;
+    int label = labels[static_cast<size_t>(pos.y) * width + pos.x];
+    return label < 0 ? -1 : find(label);
+}
+
+bool RegionMap::sameRegion(sf::Vector2i a, sf::Vector2i b) const {
+    int regionA = regionOf(a);
+    return regionA >= 0 && regionA == regionOf(b);
+}
+
+int RegionMap::regionSize(int region) const {
+    if (region < 0 || region >= static_cast<int>(parent.size())) return 0;
+    return sizes[find(region)];
+}
+
+int RegionMap::largestRegion() const {
+    int best = -1;
+    for (size_t i = 0; i < parent.size(); i++) {
+        if (parent[i] != static_cast<int>(i) || sizes[i] == 0) continue;
+        if (best < 0 || sizes[i] > sizes[best]) {
+            best = static_cast<int>(i);
+        }
+    }
+    return best;
+}
+
+size_t RegionMap::memoryUsage() const {
+    return (labels.capacity() + parent.capacity() + sizes.capacity()) * sizeof(int);
+}
+
+std::vector<std::vector<sf::Vector2i>> RegionMap::collectRegions() const {
+    std::vector<std::vector<sf::Vector2i>> regions;
+    std::vector<int> slot(parent.size(), -1);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            int label = labels[static_cast<size_t>(y) * width + x];
+            if (label < 0) continue;
+
+            int root = find(label);
+            if (slot[root] < 0) {
+                slot[root] = static_cast<int>(regions.size());
+                regions.emplace_back();
+                regions.back().reserve(sizes[root]);
+            }
+            regions[slot[root]].emplace_back(x, y);
+        }
+    }
+    return regions;
+}
+
+// union-find helpers
+int RegionMap::find(int label) const {
+    while (parent[label] != label) label = parent[label];
+    return label;
+}
+
+int RegionMap::compress(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]]; // path halving
+        label = parent[label];
+    }
+    return label;
+}
+
+void RegionMap::flatten() {
+    for (size_t i = 0; i < parent.size(); i++) {
+        parent[i] = compress(static_cast<int>(i));
+    }
+}
+
+int RegionMap::unite(int a, int b) {
+    int rootA = compress(a);
+    int rootB = compress(b);
+    if (rootA == rootB) return rootA;
+
+    if (sizes[rootA] < sizes[rootB]) std::swap(rootA, rootB);
+    parent[rootB] = rootA;
+    sizes[rootA] += sizes[rootB];
+    sizes[rootB] = 0;
+    activeRegions--;
+    return rootA;
+}
+
+int RegionMap::newLabel() {
+    int label = static_cast<int>(parent.size());
+    parent.push_back(label);
+    sizes.push_back(0);
+    activeRegions++;
+    return label;
+}
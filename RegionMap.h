@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "Bitboard.h"
+#include "TileMap.h"
+
+// Connected-component labels for the walkable (0) tiles of a maze.
+// Built once per level with a scanline union-find pass over bitboard runs,
+// so "are these two tiles connected?" is a label comparison instead of a
+// flood fill.
+class RegionMap : public TileMap::Listener {
+public:
+    // Relabels the whole maze
+    void build(const std::vector<std::vector<int>>& maze);
+    void build(const TileMap& tiles);
+    void build(const Bitboard& floor);
+
+    // Call after maze[y][x] has changed. Carving merges neighbouring regions
+    // in place; walling a tile only relabels when it could split a region.
+    void updateTile(const std::vector<std::vector<int>>& maze, int x, int y);
+    // Same for edits made through TileMap::setTile / carveRect
+    void onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) override;
+
+    // Region id of a tile, -1 for walls and out of bounds
+    int regionOf(sf::Vector2i pos) const;
+    bool sameRegion(sf::Vector2i a, sf::Vector2i b) const;
+    bool isWalkable(sf::Vector2i pos) const { return regionOf(pos) >= 0; }
+
+    int regionCount() const { return activeRegions; }
+    int regionSize(int region) const;
+    int largestRegion() const;
+
+    // Tiles of every region, one list per region in scan order
+    std::vector<std::vector<sf::Vector2i>> collectRegions() const;
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    // Heap bytes held; labels are one int per tile
+    size_t memoryUsage() const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int activeRegions = 0;
+
+    // Per tile provisional label, -1 for walls
+    std::vector<int> labels;
+    // Union-find over labels; roots carry the region size. Only edits write
+    // it, and they flatten it again, so const queries are safe to run from
+    // several threads at once.
+    std::vector<int> parent;
+    std::vector<int> sizes;
+
+    // Root lookup for queries; never writes
+    int find(int label) const;
+    // Root lookup with path halving, for building and edits
+    int compress(int label);
+    // Points every label straight at its root
+    void flatten();
+    int unite(int a, int b);
+    int newLabel();
+    bool applyTile(int x, int y, const std::function<bool(int, int)>& isFloor);
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "RenderSnapshot.h"
+
+// Where finished frames go. The game fills frame() every render and calls
+// present(); the window backend shows it, the null backend throws it away
+// so the simulation can run without a display.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual bool isOpen() const = 0;
+    virtual void close() = 0;
+    virtual bool pollEvent(sf::Event& event) = 0;
+    virtual sf::Vector2u getSize() const = 0;
+
+    // Snapshot to fill for the next present(), already reset
+    virtual RenderSnapshot& frame() = 0;
+    virtual void present() = 0;
+
+    // The real window, or null when there is nothing to draw to or read
+    // the keyboard and mouse from
+    virtual sf::RenderWindow* getWindow() = 0;
+    // Takes the window back from any background drawing so menus can draw
+    // to it directly; the next present() hands it over again
+    virtual void holdWindow() {}
+};
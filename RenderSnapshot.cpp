@@ -0,0 +1,121 @@
+#include "RenderSnapshot.h"
+#include "Profiler.h"
+
+void RenderSnapshot::reset() {
+    view = sf::View();
+    commands.clear();
+    clearColors.clear();
+    views.clear();
+    sprites.clear();
+    texts.clear();
+    rectangles.clear();
+    circles.clear();
+    convexShapes.clear();
+    primitives.clear();
+    vertices.clear();
+}
+
+void RenderSnapshot::clear(const sf::Color& color) {
+    commands.push_back({ Kind::Clear, clearColors.size() });
+    clearColors.push_back(color);
+}
+
+void RenderSnapshot::setView(const sf::View& newView) {
+    view = newView;
+    commands.push_back({ Kind::View, views.size() });
+    views.push_back(newView);
+}
+
+void RenderSnapshot::draw(const sf::Sprite& sprite) {
+    commands.push_back({ Kind::Sprite, sprites.size() });
+    sprites.push_back(sprite);
+}
+
+void RenderSnapshot::draw(const sf::Text& text) {
+    commands.push_back({ Kind::Text, texts.size() });
+    texts.push_back(text);
+}
+
+void RenderSnapshot::draw(const sf::RectangleShape& shape) {
+    commands.push_back({ Kind::Rectangle, rectangles.size() });
+    rectangles.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::CircleShape& shape) {
+    commands.push_back({ Kind::Circle, circles.size() });
+    circles.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::ConvexShape& shape) {
+    commands.push_back({ Kind::Convex, convexShapes.size() });
+    convexShapes.push_back(shape);
+}
+
+void RenderSnapshot::draw(const sf::VertexArray& vertexArray) {
+    commands.push_back({ Kind::Primitives, primitives.size() });
+    primitives.push_back({ vertices.size(), vertexArray.getVertexCount(), vertexArray.getPrimitiveType() });
+    for (std::size_t i = 0; i < vertexArray.getVertexCount(); i++) {
+        vertices.push_back(vertexArray[i]);
+    }
+}
+
+void RenderSnapshot::draw(const sf::Vertex* first, std::size_t count, sf::PrimitiveType type) {
+    commands.push_back({ Kind::Primitives, primitives.size() });
+    primitives.push_back({ vertices.size(), count, type });
+    vertices.insert(vertices.end(), first, first + count);
+}
+
+std::size_t RenderSnapshot::drawCallCount() const {
+    return commands.size() - clearColors.size() - views.size();
+}
+
+std::size_t RenderSnapshot::vertexCount() const {
+    // Fan fill plus a strip outline when it has one
+    auto shapeVertices = [](const sf::Shape& shape) {
+        std::size_t points = shape.getPointCount();
+        return points + 2 + (shape.getOutlineThickness() != 0.f ? (points + 1) * 2 : 0);
+    };
+
+    std::size_t count = sprites.size() * 4 + vertices.size();
+    for (const auto& text : texts) count += text.getString().getSize() * 6;
+    for (const auto& shape : rectangles) count += shapeVertices(shape);
+    for (const auto& shape : circles) count += shapeVertices(shape);
+    for (const auto& shape : convexShapes) count += shapeVertices(shape);
+    return count;
+}
+
+void RenderSnapshot::replay(sf::RenderTarget& target) const {
+    PROFILE_SCOPE("RenderSnapshot::replay");
+    for (const Command& command : commands) {
+        switch (command.kind) {
+        case Kind::Clear:
+            target.clear(clearColors[command.index]);
+            break;
+        case Kind::View:
+            target.setView(views[command.index]);
+            break;
+        case Kind::Sprite:
+            target.draw(sprites[command.index]);
+            break;
+        case Kind::Text:
+            target.draw(texts[command.index]);
+            break;
+        case Kind::Rectangle:
+            target.draw(rectangles[command.index]);
+            break;
+        case Kind::Circle:
+            target.draw(circles[command.index]);
+            break;
+        case Kind::Convex:
+            target.draw(convexShapes[command.index]);
+            break;
+        case Kind::Primitives: {
+            const Primitives& batch = primitives[command.index];
+            if (batch.count > 0) {
+                target.draw(&vertices[batch.first], batch.count, batch.type);
+            }
+            break;
+        }
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+
+// Everything one frame draws, recorded by value so the simulation can move
+// on while the render thread draws it. Offers the part of sf::RenderTarget
+// the game's draw code uses, so that code records into a snapshot exactly
+// as it would draw into the window.
+// Sprites and texts keep pointers to their texture and font: the owner has
+// to keep those alive until the snapshot has been drawn.
+class RenderSnapshot {
+public:
+    // Empties the snapshot but keeps its storage for the next frame
+    void reset();
+
+    void clear(const sf::Color& color = sf::Color::Black);
+    void setView(const sf::View& view);
+    const sf::View& getView() const { return view; }
+
+    void draw(const sf::Sprite& sprite);
+    void draw(const sf::Text& text);
+    void draw(const sf::RectangleShape& shape);
+    void draw(const sf::CircleShape& shape);
+    void draw(const sf::ConvexShape& shape);
+    void draw(const sf::VertexArray& vertexArray);
+    void draw(const sf::Vertex* first, std::size_t count, sf::PrimitiveType type);
+
+    // Issues the recorded calls in order
+    void replay(sf::RenderTarget& target) const;
+
+    std::size_t commandCount() const { return commands.size(); }
+    // Draw calls replay() will issue and the vertices they submit (shapes as
+    // SFML tessellates them, texts at six per character)
+    std::size_t drawCallCount() const;
+    std::size_t vertexCount() const;
+
+private:
+    enum class Kind { Clear, View, Sprite, Text, Rectangle, Circle, Convex, Primitives };
+    struct Command {
+        Kind kind;
+        std::size_t index;
+    };
+    struct Primitives {
+        std::size_t first;
+        std::size_t count;
+        sf::PrimitiveType type;
+    };
+
+    sf::View view; // last one set, for code that anchors to the camera
+    std::vector<Command> commands;
+    std::vector<sf::Color> clearColors;
+    std::vector<sf::View> views;
+    std::vector<sf::Sprite> sprites;
+    std::vector<sf::Text> texts;
+    std::vector<sf::RectangleShape> rectangles;
+    std::vector<sf::CircleShape> circles;
+    std::vector<sf::ConvexShape> convexShapes;
+    std::vector<Primitives> primitives;
+    std::vector<sf::Vertex> vertices;
+};
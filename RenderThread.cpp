@@ -0,0 +1,76 @@
+#include "RenderThread.h"
+#include "Profiler.h"
+#include <utility>
+
+RenderThread::RenderThread(sf::RenderWindow& window) : window(window) {
+}
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::start() {
+    if (isRunning()) return;
+    stopping = false;
+    // A context can only be active on one thread at a time
+    window.setActive(false);
+    thread = std::thread(&RenderThread::loop, this);
+}
+
+void RenderThread::stop() {
+    if (!isRunning()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    thread.join();
+    window.setActive(true);
+
+    // Frames never drawn are dropped; nothing refers to them any more
+    fresh = false;
+    drawn = published;
+}
+
+void RenderThread::publish() {
+    PROFILE_SCOPE("RenderThread::publish");
+    if (!isRunning()) {
+        back().replay(window);
+        window.display();
+        back().reset();
+        drawn = ++published;
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return !fresh; });
+        std::swap(backIndex, readyIndex);
+        fresh = true;
+        published++;
+    }
+    changed.notify_all();
+    buffers[backIndex].reset();
+}
+
+void RenderThread::loop() {
+    Profiler::setThreadName("render");
+    window.setActive(true);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            changed.wait(lock, [this]() { return fresh || stopping; });
+            if (stopping) break;
+            std::swap(frontIndex, readyIndex);
+            fresh = false;
+        }
+        changed.notify_all();
+
+        buffers[frontIndex].replay(window);
+        window.display();
+        drawn++;
+    }
+
+    window.setActive(false);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "RenderSnapshot.h"
+
+// Draws published snapshots on its own thread, which owns the window's
+// OpenGL context while running. Three snapshots rotate: the simulation
+// fills the back one, the render thread draws the front one, and the most
+// recently published one waits in between, so building frame N + 1
+// overlaps drawing frame N.
+// Events are still polled on the thread that created the window.
+class RenderThread {
+public:
+    explicit RenderThread(sf::RenderWindow& window);
+    ~RenderThread();
+
+    RenderThread(const RenderThread&) = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    // Hands the window to the render thread; no-op when already running
+    void start();
+    // Waits for the frame being drawn and hands the window back to the
+    // calling thread, which may then draw or close it
+    void stop();
+    bool isRunning() const { return thread.joinable(); }
+
+    // Snapshot to fill next, already reset. Only the publishing thread uses it.
+    RenderSnapshot& back() { return buffers[backIndex]; }
+    // Passes the back snapshot on. Waits while the one published before has
+    // not been picked up yet, which paces the simulation to the display.
+    // When the thread is not running the snapshot is drawn right here.
+    void publish();
+
+    // Snapshots handed over / fully drawn so far. Everything a snapshot
+    // points to may be freed once framesDrawn() reaches its number.
+    std::uint64_t framesPublished() const { return published; }
+    std::uint64_t framesDrawn() const { return drawn.load(); }
+
+private:
+    sf::RenderWindow& window;
+    RenderSnapshot buffers[3];
+    int backIndex = 0;
+    int readyIndex = 1;
+    int frontIndex = 2;
+    bool fresh = false;    // ready holds a snapshot not drawn yet
+    bool stopping = false;
+    std::uint64_t published = 0;
+    std::atomic<std::uint64_t> drawn{ 0 };
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::thread thread;
+
+    void loop();
+};
@@ -0,0 +1,163 @@
+#include "Replay.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+namespace {
+    const char magic[4] = { 'M', 'Z', 'R', 'P' };
+
+    enum Buttons : std::uint8_t {
+        Left = 1 << 0,
+        Right = 1 << 1,
+        Up = 1 << 2,
+        Down = 1 << 3,
+        Sprint = 1 << 4,
+        Dash = 1 << 5,
+        Attack = 1 << 6,
+        Charge = 1 << 7
+    };
+
+    std::uint8_t packButtons(const PlayerInput& input) {
+        std::uint8_t buttons = 0;
+        if (input.left) buttons |= Left;
+        if (input.right) buttons |= Right;
+        if (input.up) buttons |= Up;
+        if (input.down) buttons |= Down;
+        if (input.sprint) buttons |= Sprint;
+        if (input.dash) buttons |= Dash;
+        if (input.attack) buttons |= Attack;
+        if (input.charge) buttons |= Charge;
+        return buttons;
+    }
+
+    PlayerInput unpackButtons(std::uint8_t buttons, sf::Vector2f aim) {
+        PlayerInput input;
+        input.left = (buttons & Left) != 0;
+        input.right = (buttons & Right) != 0;
+        input.up = (buttons & Up) != 0;
+        input.down = (buttons & Down) != 0;
+        input.sprint = (buttons & Sprint) != 0;
+        input.dash = (buttons & Dash) != 0;
+        input.attack = (buttons & Attack) != 0;
+        input.charge = (buttons & Charge) != 0;
+        input.aim = aim;
+        return input;
+    }
+
+    // Compared bit for bit: a replay has to feed back exactly what was read
+    bool sameInput(const PlayerInput& a, const PlayerInput& b) {
+        return packButtons(a) == packButtons(b) && std::memcmp(&a.aim, &b.aim, sizeof(a.aim)) == 0;
+    }
+
+    template <typename T>
+    void put(std::vector<std::uint8_t>& out, T value) {
+        std::uint8_t bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Bounds-checked reader over the mapped bytes
+    struct Reader {
+        const std::uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+        bool ok = true;
+
+        template <typename T>
+        T get() {
+            T value{};
+            if (offset + sizeof(T) > size) {
+                ok = false;
+                return value;
+            }
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+    };
+
+    const size_t runBytes = 11;
+    const size_t checkpointBytes = 12;
+}
+
+bool Replay::write(const std::string& path) const {
+    std::vector<std::uint8_t> runs;
+    std::uint32_t runCount = 0;
+    for (size_t i = 0; i < inputs.size(); ) {
+        size_t end = i + 1;
+        while (end < inputs.size() && end - i < std::numeric_limits<std::uint16_t>::max() &&
+            sameInput(inputs[end], inputs[i])) {
+            end++;
+        }
+        put<std::uint16_t>(runs, static_cast<std::uint16_t>(end - i));
+        put<std::uint8_t>(runs, packButtons(inputs[i]));
+        put<float>(runs, inputs[i].aim.x);
+        put<float>(runs, inputs[i].aim.y);
+        runCount++;
+        i = end;
+    }
+
+    std::vector<std::uint8_t> out;
+    out.insert(out.end(), magic, magic + 4);
+    put<std::uint32_t>(out, version);
+    put<std::uint64_t>(out, seed);
+    put<float>(out, step);
+    put<std::uint32_t>(out, steps);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(inputs.size()));
+    put<std::uint32_t>(out, runCount);
+    put<std::uint32_t>(out, static_cast<std::uint32_t>(checkpoints.size()));
+    out.insert(out.end(), runs.begin(), runs.end());
+    for (const Checkpoint& checkpoint : checkpoints) {
+        put<std::uint32_t>(out, checkpoint.step);
+        put<std::uint64_t>(out, checkpoint.hash);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    return static_cast<bool>(file);
+}
+
+std::unique_ptr<Replay> Replay::load(const std::string& path) {
+    MappedFile mapping;
+    if (!mapping.open(path)) return nullptr;
+
+    Reader in{ mapping.data(), mapping.size() };
+    if (in.size < 4 || std::memcmp(in.data, magic, 4) != 0) return nullptr;
+    in.offset = 4;
+    if (in.get<std::uint32_t>() != version) return nullptr;
+
+    auto replay = std::make_unique<Replay>();
+    replay->seed = in.get<std::uint64_t>();
+    replay->step = in.get<float>();
+    replay->steps = in.get<std::uint32_t>();
+    std::uint32_t inputCount = in.get<std::uint32_t>();
+    std::uint32_t runCount = in.get<std::uint32_t>();
+    std::uint32_t checkpointCount = in.get<std::uint32_t>();
+    if (!in.ok || !(replay->step > 0.f)) return nullptr;
+    // Counts must fit in the file before anything is reserved for them
+    if (runCount * runBytes + checkpointCount * checkpointBytes != in.size - in.offset) return nullptr;
+    if (inputCount > static_cast<size_t>(runCount) * std::numeric_limits<std::uint16_t>::max()) return nullptr;
+
+    replay->inputs.reserve(inputCount);
+    for (std::uint32_t i = 0; i < runCount; i++) {
+        std::uint16_t steps = in.get<std::uint16_t>();
+        std::uint8_t buttons = in.get<std::uint8_t>();
+        sf::Vector2f aim;
+        aim.x = in.get<float>();
+        aim.y = in.get<float>();
+        replay->inputs.insert(replay->inputs.end(), steps, unpackButtons(buttons, aim));
+    }
+    if (replay->inputs.size() != inputCount) return nullptr;
+
+    replay->checkpoints.reserve(checkpointCount);
+    for (std::uint32_t i = 0; i < checkpointCount; i++) {
+        Checkpoint checkpoint;
+        checkpoint.step = in.get<std::uint32_t>();
+        checkpoint.hash = in.get<std::uint64_t>();
+        replay->checkpoints.push_back(checkpoint);
+    }
+    if (!in.ok) return nullptr;
+    return replay;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Player.h"
+
+// A recorded run: the seed, the step length and the player's input for
+// every step, plus a hash of the game state every checkpointInterval steps.
+// Fed back through the same fixed-step simulation it reproduces the run
+// exactly (same build and platform), and the hashes show where it stops
+// doing so.
+//
+// Layout (little endian, no padding):
+//   header      "MZRP", version u32, seed u64, step f32,
+//               step count u32, input count u32, run count u32,
+//               checkpoint count u32
+//   runs        steps u16, buttons u8 (see Replay.cpp), aim 2xf32;
+//               consecutive identical inputs are stored once
+//   checkpoints step u32, hash u64
+class Replay {
+public:
+    static const std::uint32_t version = 2;
+    static const int checkpointInterval = 60;
+
+    struct Checkpoint {
+        std::uint32_t step;
+        std::uint64_t hash;
+    };
+
+    std::uint64_t seed = 0;
+    float step = 1.f / 60.f;
+    // Steps simulated; a step right after dying reads no input, so this can
+    // be more than inputs.size()
+    std::uint32_t steps = 0;
+    std::vector<PlayerInput> inputs;
+    std::vector<Checkpoint> checkpoints;
+
+    bool write(const std::string& path) const;
+    // nullptr when the file is missing, truncated or from another version
+    static std::unique_ptr<Replay> load(const std::string& path);
+};
@@ -0,0 +1,16 @@
+#include "ReplayInput.h"
+
+PlayerInput RecordingInput::read(const InputContext& context) {
+    PlayerInput input = source->read(context);
+    replay.inputs.push_back(input);
+    return input;
+}
+
+PlayerInput ReplayInput::read(const InputContext& context) {
+    if (finished()) {
+        PlayerInput idle;
+        idle.aim = context.player.getPosition();
+        return idle;
+    }
+    return replay.inputs[next++];
+}
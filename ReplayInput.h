@@ -0,0 +1,33 @@
+#pragma once
+#include "InputSource.h"
+#include "Replay.h"
+
+// Passes another source's input through and appends it to a replay
+class RecordingInput : public InputSource {
+public:
+    // replay must outlive this
+    RecordingInput(std::unique_ptr<InputSource> source, Replay& replay) : source(std::move(source)), replay(replay) {}
+
+    PlayerInput read(const InputContext& context) override;
+    void restart() override { source->restart(); }
+    bool isLive() const override { return source->isLive(); }
+
+private:
+    std::unique_ptr<InputSource> source;
+    Replay& replay;
+};
+
+// Feeds a replay's inputs back in order, then stands still. A replay spans
+// every run it recorded, so starting over does not rewind it.
+class ReplayInput : public InputSource {
+public:
+    // replay must outlive this
+    explicit ReplayInput(const Replay& replay) : replay(replay) {}
+
+    PlayerInput read(const InputContext& context) override;
+    bool finished() const { return next >= replay.inputs.size(); }
+
+private:
+    const Replay& replay;
+    size_t next = 0;
+};
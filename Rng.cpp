@@ -0,0 +1,62 @@
+#include "Rng.h"
+
+namespace {
+    std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // splitmix64 expands one seed into well mixed state words
+    std::uint64_t splitMix(std::uint64_t& x) {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+}
+
+Rng::Rng(std::uint64_t seed) {
+    std::uint64_t x = seed;
+    for (auto& word : state) {
+        word = splitMix(x);
+    }
+}
+
+Rng Rng::split(std::uint64_t streamId) const {
+    std::uint64_t mixed = state[0] ^ rotl(state[1], 23) ^ rotl(state[3], 41);
+    return Rng(mixed ^ ((streamId + 1) * 0xD1B54A32D192ED03ULL));
+}
+
+Rng Rng::forLevel(std::uint64_t seed, int level) {
+    return Rng(seed).split(Levels).split(static_cast<std::uint64_t>(level));
+}
+
+// xoshiro256**
+std::uint64_t Rng::next() {
+    std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+    std::uint64_t t = state[1] << 17;
+
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+
+    return result;
+}
+
+// Multiply-shift mapping; identical on every platform unlike std distributions
+int Rng::range(int low, int high) {
+    if (high <= low) return low;
+    std::uint64_t span = static_cast<std::uint64_t>(static_cast<std::int64_t>(high) - low) + 1;
+    return low + static_cast<int>(((next() >> 32) * span) >> 32);
+}
+
+float Rng::range(float low, float high) {
+    float unit = static_cast<float>(next() >> 40) * (1.0f / 16777216.0f);
+    return low + (high - low) * unit;
+}
+
+bool Rng::chance(float probability) {
+    return range(0.f, 1.f) < probability;
+}
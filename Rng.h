@@ -0,0 +1,51 @@
+#pragma once
+#include <cstdint>
+
+// Seeded xoshiro256** generator used for everything random in the game.
+// Child streams are derived with split() so each subsystem draws from its own
+// sequence and adding a roll in one place never shifts another.
+class Rng {
+public:
+    // Stream ids for split(); values are part of the seed contract, only append
+    enum Stream : std::uint64_t {
+        Rooms = 1,
+        OpenAreas,
+        Features,
+        DeadEnds,
+        Placement,
+        Enemies,
+        Collectables,
+        Audio,
+        Effects,
+        Chunks,
+        Levels
+    };
+
+    // UniformRandomBitGenerator so std algorithms can use it too
+    using result_type = std::uint64_t;
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+    result_type operator()() { return next(); }
+
+    explicit Rng(std::uint64_t seed = 0);
+
+    // Independent generator derived from this one's state and an id.
+    // Does not advance this generator.
+    Rng split(std::uint64_t streamId) const;
+
+    // Root stream of a level for the given game seed, split from its own
+    // Levels stream so level numbers never collide with the ids above
+    static Rng forLevel(std::uint64_t seed, int level);
+
+    std::uint64_t next();
+
+    // Uniform integer in [low, high]
+    int range(int low, int high);
+    // Uniform float in [low, high)
+    float range(float low, float high);
+    // True with the given probability
+    bool chance(float probability);
+
+private:
+    std::uint64_t state[4];
+};
@@ -0,0 +1,145 @@
+#include "RoomConnector.h"
+#include <algorithm>
+#include <cstdlib>
+#include <unordered_map>
+
+// Multi-source BFS from every region boundary, then Kruskal over the
+// closest pair found between each pair of touching regions
+std::vector<RoomConnector::Link> RoomConnector::findLinks(const std::vector<std::vector<int>>& maze, const RegionMap& regions) {
+    std::vector<Link> links;
+    int height = static_cast<int>(maze.size());
+    if (height < 3) return links;
+    int width = static_cast<int>(maze[0].size());
+    if (width < 3) return links;
+
+    size_t tileCount = static_cast<size_t>(width) * height;
+    distance.assign(tileCount, -1);
+    owner.assign(tileCount, -1);
+    source.assign(tileCount, -1);
+    frontier.clear();
+
+    // Region ids can be sparse after edits, so remap them to 0..n-1
+    std::vector<int> compact;
+    int regionTotal = 0;
+    std::vector<int> representative;
+
+    const int dx[4] = { 1, -1, 0, 0 };
+    const int dy[4] = { 0, 0, 1, -1 };
+
+    // Seed only boundary tiles: interior floor can never be closest to a wall
+    for (int y = 1; y < height - 1; y++) {
+        for (int x = 1; x < width - 1; x++) {
+            if (maze[y][x] != 0) continue;
+
+            int root = regions.regionOf({ x, y });
+            if (root < 0) continue;
+            if (root >= static_cast<int>(compact.size())) compact.resize(root + 1, -1);
+            if (compact[root] < 0) {
+                compact[root] = regionTotal++;
+                representative.push_back(y * width + x);
+            }
+
+            int index = y * width + x;
+            owner[index] = compact[root];
+            distance[index] = 0;
+            source[index] = index;
+
+            for (int d = 0; d < 4; d++) {
+                if (maze[y + dy[d]][x + dx[d]] != 0) {
+                    frontier.push_back(index);
+                    break;
+                }
+            }
+        }
+    }
+
+    if (regionTotal < 2) return links;
+
+    // Closest meeting point for each pair of regions
+    std::unordered_map<long long, Candidate> best;
+
+    for (size_t head = 0; head < frontier.size(); head++) {
+        int current = frontier[head];
+        int cx = current % width;
+        int cy = current / width;
+
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + dx[d];
+            int ny = cy + dy[d];
+            // Outer walls are never carved
+            if (nx < 1 || ny < 1 || nx > width - 2 || ny > height - 2) continue;
+
+            int next = ny * width + nx;
+            if (owner[next] < 0) {
+                owner[next] = owner[current];
+                distance[next] = distance[current] + 1;
+                source[next] = source[current];
+                frontier.push_back(next);
+            }
+            else if (owner[next] != owner[current]) {
+                int regionA = std::min(owner[current], owner[next]);
+                int regionB = std::max(owner[current], owner[next]);
+                int cost = distance[current] + distance[next];
+                long long key = static_cast<long long>(regionA) * regionTotal + regionB;
+
+                auto found = best.find(key);
+                if (found == best.end() || cost < found->second.link.cost) {
+                    Link link = {
+                        { source[current] % width, source[current] / width },
+                        { source[next] % width, source[next] / width },
+                        cost
+                    };
+                    best[key] = { regionA, regionB, link };
+                }
+            }
+        }
+    }
+
+    // Kruskal: cheapest candidates first, skipping pairs already joined
+    std::vector<Candidate> candidates;
+    candidates.reserve(best.size());
+    for (const auto& entry : best) {
+        candidates.push_back(entry.second);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+        if (a.link.cost != b.link.cost) return a.link.cost < b.link.cost;
+        if (a.regionA != b.regionA) return a.regionA < b.regionA;
+        return a.regionB < b.regionB;
+        });
+
+    treeParent.resize(regionTotal);
+    for (int i = 0; i < regionTotal; i++) {
+        treeParent[i] = i;
+    }
+
+    for (const auto& candidate : candidates) {
+        int rootA = findTree(candidate.regionA);
+        int rootB = findTree(candidate.regionB);
+        if (rootA == rootB) continue;
+
+        treeParent[rootB] = rootA;
+        links.push_back(candidate.link);
+        if (static_cast<int>(links.size()) == regionTotal - 1) break;
+    }
+
+    // Regions whose fronts never met (walled off by other rooms) get a
+    // direct link to the first region so the result is always connected
+    for (int region = 1; region < regionTotal; region++) {
+        if (findTree(region) == findTree(0)) continue;
+
+        sf::Vector2i from(representative[0] % width, representative[0] / width);
+        sf::Vector2i to(representative[region] % width, representative[region] / width);
+        treeParent[findTree(region)] = findTree(0);
+        links.push_back({ from, to, std::abs(from.x - to.x) + std::abs(from.y - to.y) });
+    }
+
+    return links;
+}
+
+int RoomConnector::findTree(int region) {
+    while (treeParent[region] != region) {
+        treeParent[region] = treeParent[treeParent[region]];
+        region = treeParent[region];
+    }
+    return region;
+}
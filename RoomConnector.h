@@ -0,0 +1,37 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include "RegionMap.h"
+
+// Finds the corridors needed to join every region of a maze.
+// Boundary tiles of all regions seed one multi-source BFS through the walls;
+// where two fronts meet we get the closest tile pair between those regions.
+// A minimum spanning tree over those candidates picks which pairs to carve.
+class RoomConnector {
+public:
+    struct Link {
+        sf::Vector2i from;
+        sf::Vector2i to;
+        int cost; // wall tiles between the two endpoints
+    };
+
+    // Links forming a spanning tree over all regions, cheapest first
+    std::vector<Link> findLinks(const std::vector<std::vector<int>>& maze, const RegionMap& regions);
+
+private:
+    struct Candidate {
+        int regionA;
+        int regionB;
+        Link link;
+    };
+
+    // Per-tile BFS state, reused between calls
+    std::vector<int> distance;
+    std::vector<int> owner;
+    std::vector<int> source;
+    std::vector<int> frontier;
+
+    // Spanning tree bookkeeping
+    std::vector<int> treeParent;
+    int findTree(int region);
+};
@@ -0,0 +1,84 @@
+#include "ScriptedInput.h"
+#include "Log.h"
+#include <fstream>
+#include <sstream>
+
+bool ScriptedInput::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        LOG_ERROR(Log::General, "Cannot open input script " << path);
+        return false;
+    }
+
+    entries.clear();
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+
+        std::istringstream words(line);
+        Entry entry;
+        if (!(words >> entry.time)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            LOG_ERROR(Log::General, path << ":" << lineNumber << ": expected a time");
+            return false;
+        }
+        if (!entries.empty() && entry.time < entries.back().time) {
+            LOG_ERROR(Log::General, path << ":" << lineNumber << ": times must not go backwards");
+            return false;
+        }
+
+        std::string word;
+        while (words >> word) {
+            if (word == "left") entry.input.left = true;
+            else if (word == "right") entry.input.right = true;
+            else if (word == "up") entry.input.up = true;
+            else if (word == "down") entry.input.down = true;
+            else if (word == "sprint") entry.input.sprint = true;
+            else if (word == "dash") entry.input.dash = true;
+            else if (word == "attack") entry.input.attack = true;
+            else if (word == "charge") entry.input.charge = true;
+            else if (word == "aim") {
+                if (!(words >> entry.aimDirection.x >> entry.aimDirection.y)) {
+                    LOG_ERROR(Log::General, path << ":" << lineNumber << ": aim needs two numbers");
+                    return false;
+                }
+                entry.hasAim = true;
+            }
+            else {
+                LOG_ERROR(Log::General, path << ":" << lineNumber << ": unknown input '" << word << "'");
+                return false;
+            }
+        }
+        entries.push_back(entry);
+    }
+    restart();
+    return true;
+}
+
+PlayerInput ScriptedInput::read(const InputContext& context) {
+    // The entry in effect at the start of this step
+    while (current < entries.size() && entries[current].time <= time) {
+        current++;
+    }
+    time += context.deltaTime;
+
+    PlayerInput input;
+    input.aim = context.player.getPosition();
+    if (current == 0) return input;
+
+    const Entry& entry = entries[current - 1];
+    sf::Vector2f aim = input.aim;
+    input = entry.input;
+    input.aim = aim;
+    if (entry.hasAim) {
+        input.aim += entry.aimDirection * context.tileSize * 4.f;
+    }
+    return input;
+}
+
+void ScriptedInput::restart() {
+    current = 0;
+    time = 0.f;
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include "InputSource.h"
+
+// Replays a fixed timeline of held inputs. Each entry holds from its time
+// until the next one; before the first and with no entries at all the
+// player stands still. Time is counted in simulation steps, so a script
+// plays out the same at any frame rate.
+//
+// File format, one entry per line, '#' starts a comment:
+//   <seconds> [left] [right] [up] [down] [sprint] [dash] [attack] [charge] [aim <dx> <dy>]
+// aim is a direction from the player; without it the player aims where it
+// faces. A line with only a time releases everything.
+class ScriptedInput : public InputSource {
+public:
+    struct Entry {
+        float time;
+        PlayerInput input;
+        bool hasAim = false;
+        sf::Vector2f aimDirection;
+    };
+
+    // Entries must be added in time order
+    void add(const Entry& entry) { entries.push_back(entry); }
+    // False (with the offending line on stderr) when the file cannot be read
+    bool loadFromFile(const std::string& path);
+
+    PlayerInput read(const InputContext& context) override;
+    void restart() override;
+
+private:
+    std::vector<Entry> entries;
+    size_t current = 0;
+    float time = 0.f;
+};
@@ -0,0 +1,54 @@
+#include "Steering.h"
+#include "DistanceField.h"
+#include "Enemy.h"
+#include <cmath>
+
+sf::Vector2f Steering::force(sf::Vector2f position, sf::Vector2f target, const sf::Vector2f* waypoint,
+    const std::vector<Enemy*>& others, const Enemy* self, const DistanceField* walls, float tileSize,
+    float avoidanceRadius, float wallAvoidance) {
+    sf::Vector2f force(0, 0);
+
+    // Seek player
+    sf::Vector2f toTarget = target - position;
+    float distance = std::sqrt(toTarget.x * toTarget.x + toTarget.y * toTarget.y);
+    if (distance > 0) {
+        force += (toTarget / distance) * 1.5f;
+    }
+
+    // Follow path
+    if (waypoint) {
+        sf::Vector2f toWaypoint = *waypoint - position;
+        float wpDistance = std::sqrt(toWaypoint.x * toWaypoint.x + toWaypoint.y * toWaypoint.y);
+        if (wpDistance > 0) {
+            force += (toWaypoint / wpDistance) * 1.2f;
+        }
+    }
+
+    // Avoid other enemies
+    for (const Enemy* other : others) {
+        if (other == self || !other->isAlive()) continue;
+
+        sf::Vector2f away = position - other->getPosition();
+        float dist = std::sqrt(away.x * away.x + away.y * away.y);
+        if (dist < avoidanceRadius && dist > 0) {
+            force += (away / dist) * (1.0f - dist / avoidanceRadius) * 2.0f;
+        }
+    }
+
+    // Avoid walls: one field sample instead of probing nearby tiles
+    if (walls) {
+        sf::Vector2f tilePosition = position / tileSize;
+        float clearance = walls->sample(tilePosition);
+        if (clearance < wallAvoidance) {
+            force += walls->gradient(tilePosition) * (1.0f - clearance / wallAvoidance) * 2.0f;
+        }
+    }
+
+    // Normalize
+    float forceLength = std::sqrt(force.x * force.x + force.y * force.y);
+    if (forceLength > 0) {
+        force /= forceLength;
+    }
+
+    return force;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+class DistanceField;
+class Enemy;
+
+// Where an enemy wants to move: towards the player and its next path
+// waypoint, away from enemies close by and from walls. Enemy::update
+// applies it every step; the benchmarks time it on its own.
+class Steering {
+public:
+    // Distance (pixels) inside which enemies push each other apart
+    static constexpr float defaultAvoidanceRadius = 80.f;
+    // Clearance (tiles) from walls steering tries to keep
+    static constexpr float defaultWallAvoidance = 1.5f;
+
+    // Unit direction, or zero when nothing pulls. self is skipped among
+    // others; waypoint and walls may be null.
+    static sf::Vector2f force(sf::Vector2f position, sf::Vector2f target, const sf::Vector2f* waypoint,
+        const std::vector<Enemy*>& others, const Enemy* self, const DistanceField* walls, float tileSize,
+        float avoidanceRadius = defaultAvoidanceRadius, float wallAvoidance = defaultWallAvoidance);
+};
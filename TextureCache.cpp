@@ -0,0 +1,63 @@
+#include "TextureCache.h"
+#include "Log.h"
+#include "Metrics.h"
+
+TextureCache& TextureCache::instance() {
+    static TextureCache cache;
+    return cache;
+}
+
+void TextureCache::setGraphicsEnabled(bool enabled) {
+    instance().enabled = enabled;
+}
+
+bool TextureCache::graphicsEnabled() {
+    return instance().enabled;
+}
+
+const sf::Texture* TextureCache::get(const std::string& path) {
+    TextureCache& cache = instance();
+    if (!cache.enabled) return nullptr;
+
+    auto found = cache.images.find(path);
+    if (found == cache.images.end()) {
+        auto texture = std::make_unique<sf::Texture>();
+        if (!texture->loadFromFile(path)) {
+            LOG_ERROR(Log::Assets, "Failed to load " << path);
+            texture.reset();
+        }
+        else {
+            Metrics::add(Metrics::TextureBytes, static_cast<std::int64_t>(texture->getSize().x) * texture->getSize().y * 4);
+        }
+        found = cache.images.emplace(path, std::move(texture)).first;
+    }
+    return found->second.get();
+}
+
+const std::vector<const sf::Texture*>& TextureCache::sheet(const std::string& path, int count, sf::Vector2i frameSize) {
+    TextureCache& cache = instance();
+    // Keyed by the cut too, the same image may be split differently
+    std::string key = path + "#" + std::to_string(count) + "x" + std::to_string(frameSize.x) + "x" + std::to_string(frameSize.y);
+
+    auto found = cache.sheets.find(key);
+    if (found != cache.sheets.end()) return found->second;
+
+    std::vector<const sf::Texture*>& strip = cache.sheets[key];
+    if (!cache.enabled) {
+        strip.assign(count, nullptr);
+        return strip;
+    }
+
+    const sf::Texture* source = get(path);
+    if (!source) return strip;
+
+    sf::Image image = source->copyToImage();
+    for (int i = 0; i < count; i++) {
+        auto frame = std::make_unique<sf::Texture>();
+        frame->loadFromImage(image, sf::IntRect(i * frameSize.x, 0, frameSize.x, frameSize.y));
+        Metrics::add(Metrics::TextureBytes, static_cast<std::int64_t>(frameSize.x) * frameSize.y * 4);
+        strip.push_back(frame.get());
+        cache.frames.push_back(std::move(frame));
+    }
+    return strip;
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Textures shared by every entity, loaded on first use and kept for the
+// whole run. Spawning an enemy no longer reloads its sprite sheets, and
+// recorded frames can point at textures without lifetime worries.
+// With graphics disabled (headless runs, where no GL context may exist)
+// nothing is loaded: lookups return null frames, but as many as the sheet
+// has, so animations keep their timing. Main thread only.
+class TextureCache {
+public:
+    // Must be called before the first lookup
+    static void setGraphicsEnabled(bool enabled);
+    static bool graphicsEnabled();
+
+    // Whole image; null when graphics are off or it failed to load
+    static const sf::Texture* get(const std::string& path);
+    // A horizontal strip of count frames, each frameSize; empty when it
+    // failed to load
+    static const std::vector<const sf::Texture*>& sheet(const std::string& path, int count, sf::Vector2i frameSize);
+
+    // Sets the sprite's texture unless it is null
+    static void apply(sf::Sprite& sprite, const sf::Texture* texture) {
+        if (texture) sprite.setTexture(*texture);
+    }
+
+private:
+    bool enabled = true;
+    std::map<std::string, std::unique_ptr<sf::Texture>> images;
+    std::vector<std::unique_ptr<sf::Texture>> frames; // owned by sheets below
+    std::map<std::string, std::vector<const sf::Texture*>> sheets;
+
+    static TextureCache& instance();
+};
@@ -0,0 +1,164 @@
+#include "TileMap.h"
+#include <algorithm>
+
+TileMap::TileMap(int width, int height, std::uint8_t fill)
+    : width(std::max(0, width)), height(std::max(0, height)) {
+    chunksX = (this->width + chunkSize - 1) / chunkSize;
+    chunksY = (this->height + chunkSize - 1) / chunkSize;
+    tiles.assign(static_cast<size_t>(this->width) * this->height, fill);
+}
+
+TileMap TileMap::fromGrid(const std::vector<std::vector<int>>& grid) {
+    int gridHeight = static_cast<int>(grid.size());
+    int gridWidth = gridHeight > 0 ? static_cast<int>(grid[0].size()) : 0;
+    TileMap map(gridWidth, gridHeight, 1);
+
+    for (int y = 0; y < gridHeight; y++) {
+        std::transform(grid[y].begin(), grid[y].begin() + gridWidth, map.tiles.begin() + static_cast<size_t>(y) * gridWidth,
+            [](int tile) { return static_cast<std::uint8_t>(tile); });
+    }
+    return map;
+}
+
+TileMap TileMap::fromPacked(int width, int height, const std::vector<PackedChunk>& packed) {
+    TileMap map(width, height, 1);
+    for (int cy = 0; cy < map.chunksY; cy++) {
+        for (int cx = 0; cx < map.chunksX; cx++) {
+            size_t index = static_cast<size_t>(cy) * map.chunksX + cx;
+            if (index < packed.size()) map.unpack(packed[index], cx, cy);
+        }
+    }
+    return map;
+}
+
+bool TileMap::isValidChunk(const PackedChunk& packed) {
+    if (!packed.data || packed.size % 2 != 0) return false;
+    size_t tiles = 0;
+    for (size_t i = 0; i < packed.size; i += 2) {
+        tiles += packed.data[i];
+    }
+    return tiles == static_cast<size_t>(chunkSize) * chunkSize;
+}
+
+void TileMap::set(int x, int y, std::uint8_t value) {
+    if (!inBounds(x, y)) return;
+    tiles[static_cast<size_t>(y) * width + x] = value;
+}
+
+void TileMap::setTile(int x, int y, std::uint8_t value) {
+    if (!inBounds(x, y) || get(x, y) == value) return;
+    set(x, y, value);
+    changed({ x, y, x, y });
+}
+
+//opens up a rectangle of floor; only the tiles that were wall count as changed
+void TileMap::carveRect(int x, int y, int w, int h) {
+    TileRect area{ width, height, -1, -1 };
+    for (int ty = std::max(0, y); ty < std::min(height, y + h); ty++) {
+        for (int tx = std::max(0, x); tx < std::min(width, x + w); tx++) {
+            if (get(tx, ty) == 0) continue;
+            set(tx, ty, 0);
+            area.x0 = std::min(area.x0, tx);
+            area.y0 = std::min(area.y0, ty);
+            area.x1 = std::max(area.x1, tx);
+            area.y1 = std::max(area.y1, ty);
+        }
+    }
+    if (area.x0 <= area.x1) changed(area);
+}
+
+void TileMap::addListener(Listener* listener) {
+    if (std::find(listeners.begin(), listeners.end(), listener) == listeners.end()) {
+        listeners.push_back(listener);
+    }
+}
+
+void TileMap::removeListener(Listener* listener) {
+    listeners.erase(std::remove(listeners.begin(), listeners.end(), listener), listeners.end());
+}
+
+std::vector<TileMap::TileRect> TileMap::takeDirty() {
+    std::vector<TileRect> areas;
+    areas.swap(dirtyAreas);
+    return areas;
+}
+
+void TileMap::changed(const TileRect& area) {
+    if (dirtyAreas.size() >= maxDirtyAreas) {
+        TileRect bounds = area;
+        for (const TileRect& dirty : dirtyAreas) {
+            bounds.x0 = std::min(bounds.x0, dirty.x0);
+            bounds.y0 = std::min(bounds.y0, dirty.y0);
+            bounds.x1 = std::max(bounds.x1, dirty.x1);
+            bounds.y1 = std::max(bounds.y1, dirty.y1);
+        }
+        dirtyAreas.assign(1, bounds);
+    }
+    else {
+        dirtyAreas.push_back(area);
+    }
+    for (Listener* listener : listeners) {
+        listener->onTilesChanged(*this, area);
+    }
+}
+
+Bitboard TileMap::walkable() const {
+    Bitboard floor(width, height);
+    for (int y = 0; y < height; y++) {
+        const std::uint8_t* row = tiles.data() + static_cast<size_t>(y) * width;
+        int x = 0;
+        while (x < width) {
+            if (row[x] != 0) {
+                x++;
+                continue;
+            }
+            int start = x;
+            while (x < width && row[x] == 0) x++;
+            floor.fillSpan(y, start, x - 1);
+        }
+    }
+    return floor;
+}
+
+std::vector<std::vector<std::uint8_t>> TileMap::packedChunks() const {
+    std::vector<std::vector<std::uint8_t>> result(static_cast<size_t>(chunksX) * chunksY);
+    for (int cy = 0; cy < chunksY; cy++) {
+        for (int cx = 0; cx < chunksX; cx++) {
+            pack(cx, cy, result[static_cast<size_t>(cy) * chunksX + cx]);
+        }
+    }
+    return result;
+}
+
+// Run-length encoding of one chunk in row order
+void TileMap::pack(int chunkX, int chunkY, std::vector<std::uint8_t>& out) const {
+    out.clear();
+    int run = 0;
+    std::uint8_t value = 0;
+    for (int y = chunkY * chunkSize; y < (chunkY + 1) * chunkSize; y++) {
+        for (int x = chunkX * chunkSize; x < (chunkX + 1) * chunkSize; x++) {
+            std::uint8_t tile = get(x, y);
+            if (run > 0 && (tile != value || run == 255)) {
+                out.push_back(static_cast<std::uint8_t>(run));
+                out.push_back(value);
+                run = 0;
+            }
+            value = tile;
+            run++;
+        }
+    }
+    out.push_back(static_cast<std::uint8_t>(run));
+    out.push_back(value);
+}
+
+void TileMap::unpack(const PackedChunk& packed, int chunkX, int chunkY) {
+    // Never write past the chunk, even for bad input
+    int position = 0;
+    const int count = chunkSize * chunkSize;
+    for (size_t i = 0; i + 1 < packed.size && position < count; i += 2) {
+        int end = std::min<int>(position + packed.data[i], count);
+        for (; position < end; position++) {
+            set(chunkX * chunkSize + position % chunkSize, chunkY * chunkSize + position / chunkSize, packed.data[i + 1]);
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+
+// Level tiles, one byte each in row order. Level files store them as
+// fixed-size chunks, run-length encoded; in memory they stay plain bytes, so a
+// read is a single index and const access is safe from any thread.
+class TileMap {
+public:
+    // Side of the chunks level files are encoded in
+    static const int chunkSize = 64;
+    static const size_t maxDirtyAreas = 64;
+
+    // Run-length encoded bytes of one chunk
+    struct PackedChunk {
+        const std::uint8_t* data;
+        size_t size;
+    };
+
+    // Inclusive tile rectangle
+    struct TileRect {
+        int x0;
+        int y0;
+        int x1;
+        int y1;
+    };
+
+    // Caches derived from the tiles subscribe to hear about edits made with
+    // setTile / carveRect, after the tiles have changed, so each can repair
+    // just the affected area instead of rebuilding
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+        virtual void onTilesChanged(const TileMap& tiles, const TileRect& area) = 0;
+    };
+
+    TileMap() = default;
+    TileMap(int width, int height, std::uint8_t fill = 1);
+
+    static TileMap fromGrid(const std::vector<std::vector<int>>& grid);
+    // Decodes chunks in row order (e.g. from a mapped level file)
+    static TileMap fromPacked(int width, int height, const std::vector<PackedChunk>& packed);
+    // True when the bytes decode to exactly one chunk
+    static bool isValidChunk(const PackedChunk& packed);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    bool inBounds(int x, int y) const { return x >= 0 && y >= 0 && x < width && y < height; }
+
+    // Tiles outside the map read as wall
+    std::uint8_t get(int x, int y) const {
+        return inBounds(x, y) ? tiles[static_cast<size_t>(y) * width + x] : 1;
+    }
+    bool isWall(int x, int y) const { return get(x, y) != 0; }
+    // Raw write, no notification (loading and bulk setup)
+    void set(int x, int y, std::uint8_t value);
+
+    // Edits that record a dirty area and notify listeners when a tile changes
+    void setTile(int x, int y, std::uint8_t value);
+    void carveRect(int x, int y, int w, int h);
+
+    // Assigning another map over this one replaces its listeners too, so
+    // subscribe after the last assignment
+    void addListener(Listener* listener);
+    void removeListener(Listener* listener);
+    // Areas edited since the last call, for consumers that poll instead.
+    // Many unpolled edits collapse into their bounding rectangle.
+    std::vector<TileRect> takeDirty();
+
+    // Walkable tiles as a bitboard, one span per run of floor
+    Bitboard walkable() const;
+
+    // Run-length encoded form of every chunk in row order, for level files
+    std::vector<std::vector<std::uint8_t>> packedChunks() const;
+
+    size_t memoryUsage() const { return tiles.capacity(); }
+
+private:
+    int width = 0;
+    int height = 0;
+    int chunksX = 0;
+    int chunksY = 0;
+    std::vector<std::uint8_t> tiles;
+    std::vector<Listener*> listeners;
+    std::vector<TileRect> dirtyAreas;
+
+    void changed(const TileRect& area);
+
+    // (run length, value) byte pairs, runs capped at 255 tiles; tiles past
+    // the map edge are packed as wall
+    void pack(int chunkX, int chunkY, std::vector<std::uint8_t>& out) const;
+    void unpack(const PackedChunk& packed, int chunkX, int chunkY);
+};
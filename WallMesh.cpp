@@ -0,0 +1,133 @@
+#include "WallMesh.h"
+#include "Profiler.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+    int trailingZeros32(std::uint32_t word) {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, word);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(word);
+#endif
+    }
+}
+
+void WallMesh::build(const Bitboard& floor, JobSystem& jobs) {
+    PROFILE_SCOPE("WallMesh::build");
+    width = floor.getWidth();
+    height = floor.getHeight();
+    cellsX = (width + cellSize - 1) / cellSize;
+    cellsY = (height + cellSize - 1) / cellSize;
+    cells.assign(static_cast<size_t>(cellsX) * cellsY, {});
+
+    // Cells are independent, one row of them per job
+    jobs.parallelFor(cellsY, [&](int cy) {
+        std::vector<std::uint32_t> rows;
+        int y0 = cy * cellSize;
+        int rowCount = std::min(cellSize, height - y0);
+        for (int cx = 0; cx < cellsX; cx++) {
+            int x0 = cx * cellSize;
+            int columns = std::min(cellSize, width - x0);
+            std::uint32_t inside = columns == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << columns) - 1;
+
+            // Cells are 32 wide, so each is one half of a bitboard word
+            rows.resize(rowCount);
+            for (int r = 0; r < rowCount; r++) {
+                std::uint64_t word = floor.row(y0 + r)[x0 >> 6];
+                rows[r] = ~static_cast<std::uint32_t>(word >> (x0 & 63)) & inside;
+            }
+            meshCell(cx, cy, rows);
+        }
+    });
+}
+
+void WallMesh::onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) {
+    if (cells.empty() || tiles.getWidth() != width || tiles.getHeight() != height) {
+        build(tiles.walkable());
+        return;
+    }
+
+    int cx0 = std::max(0, area.x0) / cellSize;
+    int cy0 = std::max(0, area.y0) / cellSize;
+    int cx1 = std::min(width - 1, area.x1) / cellSize;
+    int cy1 = std::min(height - 1, area.y1) / cellSize;
+
+    std::vector<std::uint32_t> rows;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int x0 = cx * cellSize;
+            int y0 = cy * cellSize;
+            rows.assign(std::min(cellSize, height - y0), 0);
+            for (int r = 0; r < static_cast<int>(rows.size()); r++) {
+                for (int c = 0; c < std::min(cellSize, width - x0); c++) {
+                    if (tiles.isWall(x0 + c, y0 + r)) rows[r] |= std::uint32_t(1) << c;
+                }
+            }
+            meshCell(cx, cy, rows);
+        }
+    }
+}
+
+int WallMesh::rectCount() const {
+    size_t total = 0;
+    for (const auto& cell : cells) {
+        total += cell.size();
+    }
+    return static_cast<int>(total);
+}
+
+size_t WallMesh::memoryUsage() const {
+    size_t bytes = cells.capacity() * sizeof(std::vector<Rect>);
+    for (const auto& cell : cells) {
+        bytes += cell.capacity() * sizeof(Rect);
+    }
+    return bytes;
+}
+
+void WallMesh::query(const TileMap::TileRect& area, std::vector<Rect>& out) const {
+    int x0 = std::max(0, area.x0);
+    int y0 = std::max(0, area.y0);
+    int x1 = std::min(width - 1, area.x1);
+    int y1 = std::min(height - 1, area.y1);
+    if (x0 > x1 || y0 > y1) return;
+
+    for (int cy = y0 / cellSize; cy <= y1 / cellSize; cy++) {
+        for (int cx = x0 / cellSize; cx <= x1 / cellSize; cx++) {
+            for (const Rect& rect : cells[static_cast<size_t>(cy) * cellsX + cx]) {
+                if (rect.x <= x1 && rect.x + rect.width > x0 && rect.y <= y1 && rect.y + rect.height > y0) {
+                    out.push_back(rect);
+                }
+            }
+        }
+    }
+}
+
+// Greedy: take the first wall run of the top unfinished row, grow it down
+// while the rows below contain the whole run, clear it and repeat
+void WallMesh::meshCell(int cx, int cy, std::vector<std::uint32_t>& rows) {
+    std::vector<Rect>& rects = cells[static_cast<size_t>(cy) * cellsX + cx];
+    rects.clear();
+
+    int rowCount = static_cast<int>(rows.size());
+    for (int r = 0; r < rowCount; r++) {
+        while (rows[r] != 0) {
+            int start = trailingZeros32(rows[r]);
+            std::uint32_t beyond = ~(rows[r] >> start);
+            int length = beyond != 0 ? trailingZeros32(beyond) : cellSize - start;
+            std::uint32_t run = (length == 32 ? ~std::uint32_t(0) : (std::uint32_t(1) << length) - 1) << start;
+
+            int bottom = r + 1;
+            while (bottom < rowCount && (rows[bottom] & run) == run) bottom++;
+            for (int i = r; i < bottom; i++) {
+                rows[i] &= ~run;
+            }
+            rects.push_back({ cx * cellSize + start, cy * cellSize + r, length, bottom - r });
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Bitboard.h"
+#include "JobSystem.h"
+#include "TileMap.h"
+
+// Wall tiles merged into maximal rectangles (greedy meshing) so collision
+// tests and drawing deal with a few large boxes instead of every tile.
+// Rectangles never cross a cell boundary: the cells are the spatial index,
+// and an edit only re-meshes the cells it touches.
+// Coordinates are tiles.
+class WallMesh : public TileMap::Listener {
+public:
+    static const int cellSize = 32; // one 32-bit mask per cell row
+
+    struct Rect {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    void build(const Bitboard& floor, JobSystem& jobs = JobSystem::shared());
+    // Re-meshes the cells overlapping the edit
+    void onTilesChanged(const TileMap& tiles, const TileMap::TileRect& area) override;
+
+    bool empty() const { return cells.empty(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int rectCount() const;
+    // Heap bytes held by the rectangles and cell lists
+    size_t memoryUsage() const;
+
+    // Appends every rectangle overlapping the inclusive tile area to out;
+    // each one appears at most once
+    void query(const TileMap::TileRect& area, std::vector<Rect>& out) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int cellsX = 0;
+    int cellsY = 0;
+    std::vector<std::vector<Rect>> cells;
+
+    // rows holds one wall mask per tile row of the cell, bit 0 = left column
+    void meshCell(int cx, int cy, std::vector<std::uint32_t>& rows);
+};
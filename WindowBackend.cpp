@@ -0,0 +1,21 @@
+#include "WindowBackend.h"
+
+WindowBackend::WindowBackend(unsigned int width, unsigned int height, const std::string& title)
+    : window(sf::VideoMode(width, height), title) {
+    window.setVerticalSyncEnabled(true);
+}
+
+WindowBackend::~WindowBackend() {
+    renderer.stop();
+}
+
+// The render thread has to let go of the context before the window closes
+void WindowBackend::close() {
+    renderer.stop();
+    window.close();
+}
+
+void WindowBackend::present() {
+    renderer.start();
+    renderer.publish();
+}
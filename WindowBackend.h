@@ -0,0 +1,26 @@
+#pragma once
+#include <string>
+#include "RenderBackend.h"
+#include "RenderThread.h"
+
+// Draws to an SFML window through the render thread
+class WindowBackend : public RenderBackend {
+public:
+    WindowBackend(unsigned int width, unsigned int height, const std::string& title);
+    ~WindowBackend() override;
+
+    bool isOpen() const override { return window.isOpen(); }
+    void close() override;
+    bool pollEvent(sf::Event& event) override { return window.pollEvent(event); }
+    sf::Vector2u getSize() const override { return window.getSize(); }
+
+    RenderSnapshot& frame() override { return renderer.back(); }
+    void present() override;
+
+    sf::RenderWindow* getWindow() override { return &window; }
+    void holdWindow() override { renderer.stop(); }
+
+private:
+    sf::RenderWindow window;
+    RenderThread renderer{ window };
+};